@@ -0,0 +1,123 @@
+#include "0_1_memotopdown_parallel.h"
+#include "0_1_bitset.h"
+
+/**
+ * Bitset knapsack on the knapsack input files (inputs/0.txt ... inputs/5.txt)
+ * The instances carry arbitrary values, so each one is run as the two queries the
+ * bitset mode answers: reachable capacities / subset sum (val := wt) and equal values
+ * (val := 1). Results are checked against a one-byte-per-capacity reference DP, and
+ * against parallel_knapsack where its (n + 1) x (W + 1) int table fits in memory.
+ *
+ * Build: g++ -std=c++17 -O2 [-mavx2] -pthread 0_1_bitset.cpp -o 0_1_bitset
+ */
+
+// Capacity the compile-time path is instantiated for, compared with a dynamic row of the same width
+constexpr std::size_t static_capacity = 1 << 12;
+
+// int table cells above which the parallel_knapsack cross-check is skipped
+constexpr long long max_table_cells = 100000000;
+
+template <typename F>
+double time_ms(F f)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	f();
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// One byte per capacity, same recurrence: the reference the bit rows must match
+std::vector<char> reference_reachable(int W, const std::vector<int> &wt)
+{
+	std::vector<char> reach(W + 1, 0);
+	reach[0] = 1;
+	for (int w : wt)
+	{
+		for (int c = W; c >= w; --c)
+			reach[c] |= reach[c - w];
+	}
+	return reach;
+}
+
+bool check(bool ok, const std::string &what)
+{
+	if (!ok)
+		std::cerr << "Error: mismatch in " << what << std::endl;
+	return ok;
+}
+
+int main(int argc, char *argv[])
+{
+	std::vector<std::string> input_files = {"inputs/0.txt", "inputs/1.txt", "inputs/2.txt", "inputs/3.txt", "inputs/4.txt", "inputs/5.txt"};
+	if (argc > 1)
+		input_files.assign(argv + 1, argv + argc);
+
+	bool all_ok = true;
+	ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+
+	for (const auto &file : input_files)
+	{
+		int n, W;
+		std::vector<int> weights, values;
+		if (!readInputFile(file, n, W, weights, values))
+			continue;
+
+		std::cout << file << ": n = " << n << ", W = " << W << std::endl;
+
+		// Reachable capacities, dynamic width
+		CapacityBitset row(0);
+		double bitset_time = time_ms([&] { row = reachable_capacities(W, weights); });
+		std::cout << "  reachable capacities: " << row.count() << " of " << W + 1
+				  << ", max " << row.max_reachable() << "  (" << bitset_time << " ms, "
+				  << (W / 64 + 1) * 8 << " bytes)" << std::endl;
+
+		std::vector<char> reference;
+		double reference_time = time_ms([&] { reference = reference_reachable(W, weights); });
+		bool same = true;
+		for (int c = 0; c <= W; ++c)
+			same = same && row.test(c) == static_cast<bool>(reference[c]);
+		all_ok &= check(same, file + " reachable capacities");
+		std::cout << "  byte-per-capacity reference: " << reference_time << " ms" << std::endl;
+
+		// Compile-time width against a dynamic row of the same width; sums up to
+		// min(W, static_capacity) do not depend on the width above them
+		{
+			StaticCapacityBitset<static_capacity> fixed_row;
+			CapacityBitset same_width_row(0);
+			double fixed_time = time_ms([&] { fixed_row = reachable_capacities<static_capacity>(weights); });
+			double same_width_time = time_ms([&] { same_width_row = reachable_capacities(static_capacity, weights); });
+
+			bool fixed_same = true;
+			for (int c = 0; c <= std::min(W, fixed_row.capacity); ++c)
+				fixed_same = fixed_same && fixed_row.test(c) == row.test(c) && same_width_row.test(c) == row.test(c);
+			all_ok &= check(fixed_same, file + " compile-time capacity path");
+			std::cout << "  capacities 0.." << static_capacity << ": StaticCapacityBitset " << fixed_time
+					  << " ms, CapacityBitset " << same_width_time << " ms" << std::endl;
+		}
+
+		// Value queries against the int table
+		std::vector<int> ones(n, 1);
+		int subset_sum = bitset_knapsack(n, W, weights, weights);
+		int equal_values = bitset_knapsack(n, W, weights, ones);
+		std::cout << "  subset sum (val = wt): " << subset_sum << ", equal values (val = 1): " << equal_values << std::endl;
+
+		long long cells = static_cast<long long>(n + 1) * (W + 1);
+		if (cells <= max_table_cells)
+		{
+			int table_subset_sum = 0, table_equal_values = 0;
+			double table_time = time_ms([&] { table_subset_sum = parallel_knapsack(n, W, weights, weights, pool); });
+			table_equal_values = parallel_knapsack(n, W, weights, ones, pool);
+			all_ok &= check(table_subset_sum == subset_sum, file + " subset sum");
+			all_ok &= check(table_equal_values == equal_values, file + " equal values");
+			std::cout << "  parallel_knapsack: " << table_time << " ms, " << cells * 4 << " bytes" << std::endl;
+		}
+		else
+		{
+			std::cout << "  parallel_knapsack: skipped (int table would need " << cells * 4 / (1 << 20) << " MB)" << std::endl;
+		}
+		std::cout << std::endl;
+	}
+
+	std::cout << (all_ok ? "All results match" : "MISMATCH") << std::endl;
+	return all_ok ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/**
+ * Bitset 0/1 Knapsack
+ * For feasibility queries ("which capacities can be filled exactly?") the DP row only
+ * needs one bit per capacity: bit w is set when some subset of the items seen so far
+ * weighs exactly w. Adding an item of weight wt is then a single word-parallel
+ *
+ *     row |= row << wt
+ *
+ * over (W + 1) bits: 64 capacities per word operation (256 per AVX2 operation), instead
+ * of one 32-bit cell per capacity in the int table of parallel_knapsack.
+ *
+ * The bit row also answers two value queries exactly:
+ * - val[i] == wt[i] for all items (subset sum): the optimum is the largest reachable weight
+ * - all values equal: the optimum is that value times the largest number of items that
+ *   fit, i.e. of the smallest weights (no bitset needed)
+ * Any other instance throws std::invalid_argument from bitset_knapsack().
+ */
+
+namespace knapsack_bitset_detail
+{
+	constexpr int word_bits = 64;
+
+	inline void check_weight(int wt)
+	{
+		if (wt < 0)
+			throw std::invalid_argument("Knapsack item weights must be non-negative");
+	}
+
+	// row[i] |= (row << shift)[i] for words [first, last), from the top down, so every
+	// source word is read before it is overwritten (the update is in place)
+	inline void shift_or_words(std::uint64_t *row, std::ptrdiff_t first, std::ptrdiff_t last,
+							   std::ptrdiff_t word_shift, unsigned bit_shift)
+	{
+		// A 64-bit shift is undefined in C++: with bit_shift == 0 the carry is dropped instead
+		const std::uint64_t carry_mask = bit_shift ? ~std::uint64_t(0) : 0;
+		const unsigned carry_shift = (word_bits - bit_shift) % word_bits;
+
+		std::ptrdiff_t i = last - 1;
+
+#ifdef __AVX2__
+		// Four words per step; vector shifts by 64 yield zero, so no mask is needed here
+		const __m128i left = _mm_cvtsi32_si128(static_cast<int>(bit_shift));
+		const __m128i right = _mm_cvtsi32_si128(static_cast<int>(word_bits - bit_shift));
+		for (; i - 3 >= first; i -= 4)
+		{
+			const std::uint64_t *src = row + (i - 3 - word_shift);
+			__m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src));
+			__m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src - 1));
+			__m256i shifted = _mm256_or_si256(_mm256_sll_epi64(high, left), _mm256_srl_epi64(low, right));
+
+			__m256i *dst = reinterpret_cast<__m256i *>(row + (i - 3));
+			_mm256_storeu_si256(dst, _mm256_or_si256(_mm256_loadu_si256(dst), shifted));
+		}
+#endif
+
+		for (; i >= first; --i)
+		{
+			row[i] |= (row[i - word_shift] << bit_shift) | ((row[i - word_shift - 1] >> carry_shift) & carry_mask);
+		}
+	}
+
+	constexpr std::size_t num_words(std::size_t capacity) { return capacity / word_bits + 1; }
+
+	// Adds an item of weight wt to the row of capacities 0..capacity; reach is the largest
+	// sum any subset can have so far, so words above it (all zero) are left alone
+	inline void add_item(std::uint64_t *row, int capacity, int &reach, int wt)
+	{
+		check_weight(wt);
+		if (wt == 0 || wt > capacity)
+			return;
+
+		reach = static_cast<int>(std::min<long long>(static_cast<long long>(reach) + wt, capacity));
+
+		const std::ptrdiff_t word_shift = wt / word_bits;
+		const unsigned bit_shift = static_cast<unsigned>(wt % word_bits);
+		const std::ptrdiff_t last = reach / word_bits + 1;
+
+		// Words above word_shift have a lower neighbour to carry from; word word_shift does not
+		shift_or_words(row, word_shift + 1, last, word_shift, bit_shift);
+		row[word_shift] |= row[0] << bit_shift;
+
+		// Bits past the capacity are never reported, but keep them clear for count()
+		const unsigned used = static_cast<unsigned>(capacity % word_bits) + 1;
+		if (used < word_bits)
+			row[capacity / word_bits] &= (std::uint64_t(1) << used) - 1;
+	}
+
+	inline bool test(const std::uint64_t *row, int capacity, int w)
+	{
+		if (w < 0 || w > capacity)
+			return false;
+		return (row[w / word_bits] >> (w % word_bits)) & 1;
+	}
+
+	// Word 0 always holds bit 0 (the empty subset), so the scan stops
+	inline int max_reachable(const std::uint64_t *row, int reach)
+	{
+		std::ptrdiff_t i = reach / word_bits;
+		while (row[i] == 0)
+			--i;
+		return static_cast<int>(i) * word_bits + 63 - __builtin_clzll(row[i]);
+	}
+
+	inline std::size_t count(const std::uint64_t *row, std::size_t words)
+	{
+		std::size_t total = 0;
+		for (std::size_t i = 0; i < words; ++i)
+			total += static_cast<std::size_t>(__builtin_popcountll(row[i]));
+		return total;
+	}
+}
+
+/**
+ * Set of exactly reachable capacities 0..W, one bit each
+ * Starts as {0} (the empty subset); add_item(wt) adds wt to every subset seen so far.
+ */
+class CapacityBitset
+{
+public:
+	explicit CapacityBitset(int capacity)
+		: capacity_(capacity), reach_(0)
+	{
+		if (capacity < 0)
+			throw std::invalid_argument("Knapsack capacity must be non-negative");
+
+		words_.assign(knapsack_bitset_detail::num_words(static_cast<std::size_t>(capacity)), 0);
+		words_[0] = 1;
+	}
+
+	void add_item(int wt) { knapsack_bitset_detail::add_item(words_.data(), capacity_, reach_, wt); }
+	bool test(int w) const { return knapsack_bitset_detail::test(words_.data(), capacity_, w); }
+	int max_reachable() const { return knapsack_bitset_detail::max_reachable(words_.data(), reach_); }
+	std::size_t count() const { return knapsack_bitset_detail::count(words_.data(), words_.size()); }
+	int capacity() const { return capacity_; }
+
+private:
+	int capacity_;
+	int reach_;
+	std::vector<std::uint64_t> words_;
+};
+
+/**
+ * Compile-time capacity fast path
+ * Same row in a std::array: no allocation, and every word count and bound the
+ * shift loop sees derives from the constant W.
+ */
+template <std::size_t W>
+class StaticCapacityBitset
+{
+	static_assert(W <= static_cast<std::size_t>(std::numeric_limits<int>::max()), "Capacity must fit in an int");
+
+public:
+	StaticCapacityBitset()
+	{
+		words_.fill(0);
+		words_[0] = 1;
+	}
+
+	void add_item(int wt) { knapsack_bitset_detail::add_item(words_.data(), capacity, reach_, wt); }
+	bool test(int w) const { return knapsack_bitset_detail::test(words_.data(), capacity, w); }
+	int max_reachable() const { return knapsack_bitset_detail::max_reachable(words_.data(), reach_); }
+	std::size_t count() const { return knapsack_bitset_detail::count(words_.data(), words_.size()); }
+
+	static constexpr int capacity = static_cast<int>(W);
+
+private:
+	std::array<std::uint64_t, knapsack_bitset_detail::num_words(W)> words_;
+	int reach_ = 0;
+};
+
+inline CapacityBitset reachable_capacities(int W, const std::vector<int> &wt)
+{
+	CapacityBitset row(W);
+	for (int w : wt)
+		row.add_item(w);
+	return row;
+}
+
+template <std::size_t W>
+StaticCapacityBitset<W> reachable_capacities(const std::vector<int> &wt)
+{
+	StaticCapacityBitset<W> row;
+	for (int w : wt)
+		row.add_item(w);
+	return row;
+}
+
+// True when bitset_knapsack() answers this instance exactly
+inline bool is_bitset_instance(const std::vector<int> &wt, const std::vector<int> &val)
+{
+	return wt == val || std::adjacent_find(val.begin(), val.end(), std::not_equal_to<int>()) == val.end();
+}
+
+/**
+ * Knapsack optimum for subset-sum (val == wt) or equal-value instances
+ * Same arguments and result as parallel_knapsack; throws std::invalid_argument otherwise
+ */
+inline int bitset_knapsack(int n, int W, const std::vector<int> &wt, const std::vector<int> &val)
+{
+	std::vector<int> weights(wt.begin(), wt.begin() + n);
+	std::vector<int> values(val.begin(), val.begin() + n);
+
+	if (weights == values)
+		return reachable_capacities(W, weights).max_reachable();
+
+	if (!is_bitset_instance(weights, values))
+		throw std::invalid_argument("bitset_knapsack needs val == wt or equal values");
+
+	// Equal values: take as many items as fit, smallest first
+	std::sort(weights.begin(), weights.end());
+	long long used = 0;
+	int taken = 0;
+	for (int w : weights)
+	{
+		knapsack_bitset_detail::check_weight(w);
+		if (used + w > W)
+			break;
+		used += w;
+		++taken;
+	}
+	return n > 0 ? taken * std::max(values[0], 0) : 0;
+}
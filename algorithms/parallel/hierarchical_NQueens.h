@@ -0,0 +1,112 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <climits>
+#include <memory>
+#include <cstdlib>
+#include <stdexcept>
+
+class HierarchicalMutex {
+    std::mutex m;
+    unsigned long const hierarchy_level;
+    unsigned long previous_hierarchy_level;
+    static thread_local unsigned long this_thread_hierarchy_level;
+
+    void check_for_hierarchy_violation() {
+        if (this_thread_hierarchy_level <= hierarchy_level) {
+            throw std::logic_error("Mutex hierarchy violated");
+        }
+    }
+
+    void update_hierarchy_level() {
+        previous_hierarchy_level = this_thread_hierarchy_level;
+        this_thread_hierarchy_level = hierarchy_level;
+    }
+
+public:
+    explicit HierarchicalMutex(unsigned long level) : hierarchy_level(level), previous_hierarchy_level(0) {}
+
+    void lock() {
+        check_for_hierarchy_violation();
+        m.lock();
+        update_hierarchy_level();
+    }
+
+    void unlock() {
+        this_thread_hierarchy_level = previous_hierarchy_level;
+        m.unlock();
+    }
+
+    bool try_lock() {
+        check_for_hierarchy_violation();
+        if (!m.try_lock()) return false;
+        update_hierarchy_level();
+        return true;
+    }
+};
+
+inline thread_local unsigned long HierarchicalMutex::this_thread_hierarchy_level(ULONG_MAX);
+
+class NQueensSolver {
+    int N;
+    HierarchicalMutex count_mutex;                      // Guards solutions_count, the only shared state
+    int solutions_count;
+
+public:
+    NQueensSolver(int n) : N(n), count_mutex(1), solutions_count(0) {}
+
+    int count_solutions() {
+        solutions_count = 0;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < N; ++i) {
+            threads.emplace_back([this, i] {
+                // Threads explore disjoint subtrees (one first-row column each) on their own
+                // board, so the search itself shares nothing and takes no locks
+                std::vector<int> board(N, -1);
+                int local_count = place_queen(board, 0, i);
+
+                std::lock_guard<HierarchicalMutex> lock(count_mutex);
+                solutions_count += local_count;
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        return solutions_count;
+    }
+
+    void solve() {
+        std::cout << "Total solutions: " << count_solutions() << std::endl;
+    }
+
+private:
+    // Solutions in the subtree with a queen at (row, col)
+    int place_queen(std::vector<int>& board, int row, int col) {
+        if (!is_safe(board, row, col)) return 0;
+
+        // Counted once, at the last row (not once per column tried below it)
+        if (row == N - 1) return 1;
+
+        board[row] = col;
+
+        int count = 0;
+        for (int i = 0; i < N; ++i) {
+            count += place_queen(board, row + 1, i);
+        }
+
+        board[row] = -1;
+        return count;
+    }
+
+    bool is_safe(const std::vector<int>& board, int row, int col) {
+        for (int i = 0; i < row; ++i) {
+            if (board[i] == col || abs(board[i] - col) == abs(i - row)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
@@ -1,14 +1,12 @@
 #include <iostream>
+#include <utility>
+#include <vector>
+#include <random>
+
+#include "introsort.h"
 
 // [x]: Quicksort Template Implementation
-// NOTE: Swap Templated Function
-template <typename T>
-void swap(T* a, T* b)
-{
-    T temp = *a;
-    *a = *b;
-    *b = temp;
-}
+// NOTE: Textbook version kept for reference; introsort.h is the production engine
 
 
 // NOTE: Partition Function
@@ -38,8 +36,8 @@ int partition(T arr[], int low_index, int high_index)
         }
         else
         {
-            // COMMENT: Pass by Reference& to swap values
-            swap(&arr[low_index], &arr[high_index]);
+            // COMMENT: std::swap moves the values instead of copying them
+            std::swap(arr[low_index], arr[high_index]);
             low_index++;
             high_index--;
         }
@@ -59,8 +57,8 @@ void quicksort(T arr[], int low_index, int high_index)
     }
 
     int low_endpoint = partition(arr, low_index, high_index);
-    partition(arr, low_index, low_endpoint);
-    partition(arr, low_endpoint + 1, high_index);
+    quicksort(arr, low_index, low_endpoint);
+    quicksort(arr, low_endpoint + 1, high_index);
 }
 
 
@@ -77,6 +75,22 @@ int main()
 
     std::cout << std::endl;
 
+    // Introsort: iterator-based, any random access container
+    std::vector<int> values(1000000);
+    std::mt19937 rng(7);
+    for (auto& v : values)
+    {
+        v = static_cast<int>(rng() % 1000);
+    }
+
+    std::vector<int> copy = values;
+    introsort(values.begin(), values.end());
+    parallel_introsort(copy.begin(), copy.end(), std::greater<>());
+
+    std::cout << "introsort sorted: " << std::boolalpha << std::is_sorted(values.begin(), values.end()) << std::endl;
+    std::cout << "parallel_introsort sorted (descending): "
+              << std::is_sorted(copy.begin(), copy.end(), std::greater<>()) << std::endl;
+
     return 0;
 }
 
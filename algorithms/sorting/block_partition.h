@@ -0,0 +1,395 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/**
+ * Block Partition (BlockQuicksort, Edelkamp & Weiss)
+ * Hoare partitioning splits "compare" from "swap": each side scans a block of
+ * block_size elements and records the offsets of misplaced elements with
+ *     offsets[num] = i; num += !(x < pivot);
+ * which has no data-dependent branch. A second pass then swaps misplaced pairs
+ * (as a cyclic permutation, one move per element instead of three). On random
+ * keys this removes the ~50% mispredicted branches of the classic partition loop.
+ *
+ * Offset generation is a kernel chosen at compile time: a scalar unrolled loop
+ * by default, or AVX2 compare + movemask + lookup-table compaction when the
+ * range is contiguous int / float / double sorted with std::less (built with -mavx2).
+ */
+
+namespace block_partition_detail
+{
+    constexpr std::ptrdiff_t block_size = 64;           // Offsets must fit in unsigned char
+    constexpr std::ptrdiff_t offset_slack = 8;          // SIMD kernels store 8 offsets at a time
+
+    // Comparator is a plain "<" on an arithmetic key: comparisons are cheap and branch-free
+    template <typename T, typename Compare>
+    struct is_less_on_arithmetic
+        : std::bool_constant<std::is_arithmetic<T>::value &&
+                             (std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::less<T>>::value)>
+    {};
+
+    template <typename It, typename T>
+    struct is_contiguous_iterator
+        : std::bool_constant<std::is_same<It, T*>::value ||
+                             std::is_same<It, typename std::vector<T>::iterator>::value>
+    {};
+
+    template <typename T>
+    struct has_simd_kernel : std::false_type {};
+
+#ifdef __AVX2__
+    template <> struct has_simd_kernel<int> : std::true_type {};
+    template <> struct has_simd_kernel<float> : std::true_type {};
+    template <> struct has_simd_kernel<double> : std::true_type {};
+#endif
+
+    template <typename It, typename Compare>
+    struct use_simd_kernel
+        : std::bool_constant<has_simd_kernel<typename std::iterator_traits<It>::value_type>::value &&
+                             is_less_on_arithmetic<typename std::iterator_traits<It>::value_type, Compare>::value &&
+                             is_contiguous_iterator<It, typename std::iterator_traits<It>::value_type>::value>
+    {};
+
+    /**
+     * Scalar kernels
+     * fill_left:  offsets of elements in [first, first + n) that are not < pivot
+     * fill_right: offsets i (1-based, counted back from last) of elements last[-i] that are < pivot
+     * Offsets come out ascending on both sides.
+     */
+    template <typename RandomIt, typename T, typename Compare>
+    std::ptrdiff_t fill_left(RandomIt first, std::ptrdiff_t n, const T& pivot, unsigned char* offsets, Compare& comp)
+    {
+        std::ptrdiff_t num = 0;
+        std::ptrdiff_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            offsets[num] = static_cast<unsigned char>(i);     num += !comp(first[i], pivot);
+            offsets[num] = static_cast<unsigned char>(i + 1); num += !comp(first[i + 1], pivot);
+            offsets[num] = static_cast<unsigned char>(i + 2); num += !comp(first[i + 2], pivot);
+            offsets[num] = static_cast<unsigned char>(i + 3); num += !comp(first[i + 3], pivot);
+        }
+        for (; i < n; ++i)
+        {
+            offsets[num] = static_cast<unsigned char>(i);     num += !comp(first[i], pivot);
+        }
+        return num;
+    }
+
+    template <typename RandomIt, typename T, typename Compare>
+    std::ptrdiff_t fill_right(RandomIt last, std::ptrdiff_t n, const T& pivot, unsigned char* offsets, Compare& comp)
+    {
+        std::ptrdiff_t num = 0;
+        std::ptrdiff_t i = 1;
+        for (; i + 3 <= n; i += 4)
+        {
+            offsets[num] = static_cast<unsigned char>(i);     num += comp(last[-i], pivot);
+            offsets[num] = static_cast<unsigned char>(i + 1); num += comp(last[-(i + 1)], pivot);
+            offsets[num] = static_cast<unsigned char>(i + 2); num += comp(last[-(i + 2)], pivot);
+            offsets[num] = static_cast<unsigned char>(i + 3); num += comp(last[-(i + 3)], pivot);
+        }
+        for (; i <= n; ++i)
+        {
+            offsets[num] = static_cast<unsigned char>(i);     num += comp(last[-i], pivot);
+        }
+        return num;
+    }
+
+#ifdef __AVX2__
+    // lut[mask] packs the indices of the set bits of mask, ascending, one per byte
+    constexpr std::array<std::uint64_t, 256> make_compaction_lut()
+    {
+        std::array<std::uint64_t, 256> lut{};
+        for (int mask = 0; mask < 256; ++mask)
+        {
+            std::uint64_t packed = 0;
+            int count = 0;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                if (mask & (1 << bit)) packed |= static_cast<std::uint64_t>(bit) << (8 * count++);
+            }
+            lut[mask] = packed;
+        }
+        return lut;
+    }
+
+    constexpr std::array<std::uint64_t, 256> compaction_lut = make_compaction_lut();
+
+    // Append base + (set bit positions of mask) to offsets; returns how many were written
+    inline std::ptrdiff_t emit_offsets(unsigned mask, unsigned base, unsigned char* offsets)
+    {
+        std::uint64_t packed = compaction_lut[mask] + 0x0101010101010101ULL * base;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(offsets), _mm_cvtsi64_si128(static_cast<long long>(packed)));
+        return __builtin_popcount(mask);
+    }
+
+    // Per-type lane helpers: "ge" = !(x < pivot), "lt" = (x < pivot), as one bit per lane
+    struct SimdInt
+    {
+        static constexpr int lanes = 8;
+        using vec = __m256i;
+        static vec broadcast(int p) { return _mm256_set1_epi32(p); }
+        static vec load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static unsigned lt(vec x, vec p) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(p, x))); }
+        static unsigned ge(vec x, vec p) { return ~lt(x, p) & 0xFFu; }
+        static vec reverse(vec x) { return _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+    };
+
+    struct SimdFloat
+    {
+        static constexpr int lanes = 8;
+        using vec = __m256;
+        static vec broadcast(float p) { return _mm256_set1_ps(p); }
+        static vec load(const float* p) { return _mm256_loadu_ps(p); }
+        static unsigned lt(vec x, vec p) { return _mm256_movemask_ps(_mm256_cmp_ps(x, p, _CMP_LT_OQ)); }
+        static unsigned ge(vec x, vec p) { return _mm256_movemask_ps(_mm256_cmp_ps(x, p, _CMP_NLT_UQ)); }
+        static vec reverse(vec x) { return _mm256_permutevar8x32_ps(x, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+    };
+
+    struct SimdDouble
+    {
+        static constexpr int lanes = 4;
+        using vec = __m256d;
+        static vec broadcast(double p) { return _mm256_set1_pd(p); }
+        static vec load(const double* p) { return _mm256_loadu_pd(p); }
+        static unsigned lt(vec x, vec p) { return _mm256_movemask_pd(_mm256_cmp_pd(x, p, _CMP_LT_OQ)); }
+        static unsigned ge(vec x, vec p) { return _mm256_movemask_pd(_mm256_cmp_pd(x, p, _CMP_NLT_UQ)); }
+        static vec reverse(vec x) { return _mm256_permute4x64_pd(x, 0x1B); }
+    };
+
+    template <typename T> struct simd_ops;
+    template <> struct simd_ops<int> { using type = SimdInt; };
+    template <> struct simd_ops<float> { using type = SimdFloat; };
+    template <> struct simd_ops<double> { using type = SimdDouble; };
+
+    // SIMD kernels: full blocks only (block_size is a multiple of every lane count)
+    template <typename T>
+    std::ptrdiff_t fill_left_simd(const T* first, const T& pivot, unsigned char* offsets)
+    {
+        using ops = typename simd_ops<T>::type;
+        auto p = ops::broadcast(pivot);
+        std::ptrdiff_t num = 0;
+        for (int i = 0; i < block_size; i += ops::lanes)
+        {
+            num += emit_offsets(ops::ge(ops::load(first + i), p), i, offsets + num);
+        }
+        return num;
+    }
+
+    template <typename T>
+    std::ptrdiff_t fill_right_simd(const T* last, const T& pivot, unsigned char* offsets)
+    {
+        using ops = typename simd_ops<T>::type;
+        auto p = ops::broadcast(pivot);
+        std::ptrdiff_t num = 0;
+        for (int i = 0; i < block_size; i += ops::lanes)
+        {
+            // Lanes reversed so lane k holds last[-(i + 1 + k)]: offsets stay ascending
+            auto x = ops::reverse(ops::load(last - i - ops::lanes));
+            num += emit_offsets(ops::lt(x, p), i + 1, offsets + num);
+        }
+        return num;
+    }
+#endif
+
+    template <typename RandomIt, typename T, typename Compare>
+    std::ptrdiff_t fill_left_block(RandomIt first, const T& pivot, unsigned char* offsets, Compare& comp)
+    {
+#ifdef __AVX2__
+        if constexpr (use_simd_kernel<RandomIt, Compare>::value)
+            return fill_left_simd(&*first, pivot, offsets);
+#endif
+        return fill_left(first, block_size, pivot, offsets, comp);
+    }
+
+    template <typename RandomIt, typename T, typename Compare>
+    std::ptrdiff_t fill_right_block(RandomIt last, const T& pivot, unsigned char* offsets, Compare& comp)
+    {
+#ifdef __AVX2__
+        if constexpr (use_simd_kernel<RandomIt, Compare>::value)
+            return fill_right_simd(&*(last - 1) + 1, pivot, offsets);
+#endif
+        return fill_right(last, block_size, pivot, offsets, comp);
+    }
+
+    // Exchange num misplaced pairs; a cyclic rotation needs one move per element instead of three
+    template <typename RandomIt>
+    void swap_offsets(RandomIt left_base, RandomIt right_base, const unsigned char* offsets_left,
+                      const unsigned char* offsets_right, std::ptrdiff_t num, bool use_swaps)
+    {
+        if (use_swaps)
+        {
+            // Equal counts: plain swaps keep descending inputs linear
+            for (std::ptrdiff_t i = 0; i < num; ++i)
+            {
+                std::iter_swap(left_base + offsets_left[i], right_base - offsets_right[i]);
+            }
+        }
+        else if (num > 0)
+        {
+            RandomIt l = left_base + offsets_left[0];
+            RandomIt r = right_base - offsets_right[0];
+            auto tmp = std::move(*l);
+            *l = std::move(*r);
+            for (std::ptrdiff_t i = 1; i < num; ++i)
+            {
+                l = left_base + offsets_left[i];
+                *r = std::move(*l);
+                r = right_base - offsets_right[i];
+                *l = std::move(*r);
+            }
+            *r = std::move(tmp);
+        }
+    }
+}
+
+/**
+ * Partition [begin, end) around the pivot stored at *begin.
+ * Precondition: some element of (begin, end) is not less than the pivot
+ * (median-of-3 / ninther pivot selection guarantees this).
+ * Returns the pivot's final position: [begin, pos) < pivot <= (pos, end).
+ */
+template <typename RandomIt, typename Compare>
+RandomIt block_partition(RandomIt begin, RandomIt end, Compare& comp)
+{
+    using namespace block_partition_detail;
+
+    auto pivot = std::move(*begin);
+    RandomIt first = begin;
+    RandomIt last = end;
+
+    // Skip the prefix / suffix that is already in place
+    while (comp(*++first, pivot));
+    if (first - 1 == begin)
+        while (first < last && !comp(*--last, pivot));
+    else
+        while (!comp(*--last, pivot));
+
+    if (first < last)
+    {
+        std::iter_swap(first, last);
+        ++first;
+
+        alignas(64) unsigned char offsets_left[block_size + offset_slack];
+        alignas(64) unsigned char offsets_right[block_size + offset_slack];
+        RandomIt left_base = first;
+        RandomIt right_base = last;
+        std::ptrdiff_t num_left = 0, num_right = 0, start_left = 0, start_right = 0;
+
+        while (first < last)
+        {
+            // Refill whichever side has run out of misplaced elements
+            std::ptrdiff_t unknown = last - first;
+            std::ptrdiff_t left_split = num_left == 0 ? (num_right == 0 ? unknown / 2 : unknown) : 0;
+            std::ptrdiff_t right_split = num_right == 0 ? unknown - left_split : 0;
+
+            if (left_split >= block_size)
+            {
+                num_left = fill_left_block(first, pivot, offsets_left, comp);
+                first += block_size;
+            }
+            else if (left_split > 0)
+            {
+                num_left = fill_left(first, left_split, pivot, offsets_left, comp);
+                first += left_split;
+            }
+
+            if (right_split >= block_size)
+            {
+                num_right = fill_right_block(last, pivot, offsets_right, comp);
+                last -= block_size;
+            }
+            else if (right_split > 0)
+            {
+                num_right = fill_right(last, right_split, pivot, offsets_right, comp);
+                last -= right_split;
+            }
+
+            std::ptrdiff_t num = std::min(num_left, num_right);
+            swap_offsets(left_base, right_base, offsets_left + start_left, offsets_right + start_right,
+                         num, num_left == num_right);
+            num_left -= num;
+            num_right -= num;
+            start_left += num;
+            start_right += num;
+
+            if (num_left == 0)
+            {
+                start_left = 0;
+                left_base = first;
+            }
+            if (num_right == 0)
+            {
+                start_right = 0;
+                right_base = last;
+            }
+        }
+
+        // One side may still hold misplaced elements: move them across the boundary
+        if (num_left)
+        {
+            const unsigned char* offsets = offsets_left + start_left;
+            while (num_left--)
+            {
+                std::iter_swap(left_base + offsets[num_left], --last);
+            }
+            first = last;
+        }
+        if (num_right)
+        {
+            const unsigned char* offsets = offsets_right + start_right;
+            while (num_right--)
+            {
+                std::iter_swap(right_base - offsets[num_right], first);
+                ++first;
+            }
+        }
+    }
+
+    RandomIt pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+/**
+ * Partition [begin, end) around the pivot at *begin, sending elements equal to it left.
+ * Used when the pivot equals the element just before the range (an upper bound from an
+ * earlier partition), so everything that ends up left of the pivot equals it.
+ * Returns the pivot's final position: [begin, pos] == pivot < (pos, end).
+ */
+template <typename RandomIt, typename Compare>
+RandomIt partition_equal(RandomIt begin, RandomIt end, Compare& comp)
+{
+    auto pivot = std::move(*begin);
+    RandomIt first = begin;
+    RandomIt last = end;
+
+    while (comp(pivot, *--last));
+    if (last + 1 == end)
+        while (first < last && !comp(pivot, *++first));
+    else
+        while (!comp(pivot, *++first));
+
+    while (first < last)
+    {
+        std::iter_swap(first, last);
+        while (comp(pivot, *--last));
+        while (!comp(pivot, *++first));
+    }
+
+    *begin = std::move(*last);
+    *last = std::move(pivot);
+    return last;
+}
@@ -0,0 +1,391 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "radix_sort.h"
+#include "../../data_structures/heap/binHeap.h"
+
+/**
+ * External Merge Sort
+ * Sorts a binary file of trivially copyable records that does not fit in memory.
+ *
+ * Phase 1 (run formation): the input is read in large sequential chunks, each chunk
+ * is sorted in memory with key_sort() and written out as a sorted run. Reading chunk
+ * i + 1 and writing chunk i - 1 run asynchronously while chunk i is being sorted.
+ *
+ * Phase 2 (merge): up to fan_in runs at a time are k-way merged through a BinaryHeap
+ * of (key, run) cursors. Each run is read through two buffers (one consumed while the
+ * other is filled in the background) and the output is written the same way. If there
+ * are more runs than fan_in, intermediate passes merge groups into longer runs first.
+ *
+ * Run files are named after a unique mkstemp() prefix in temp_dir, so concurrent sorts
+ * sharing a directory never touch each other's runs (or any other existing file), and
+ * every run file is removed on return, including when an exception is thrown.
+ *
+ * The heap breaks key ties by run index, so the merge itself is stable; whole-sort
+ * stability then follows from the in-memory sort (stable for radix-sorted keys).
+ */
+
+struct ExternalSortConfig
+{
+    std::size_t memory_budget = std::size_t(256) << 20; // Bytes, for buffers of both phases
+    std::size_t fan_in = 64;                             // Runs merged at once
+    std::string temp_dir = ".";                          // Where run files are created
+};
+
+namespace external_sort_detail
+{
+    struct FileCloser
+    {
+        void operator()(std::FILE* f) const
+        {
+            if (f) std::fclose(f);
+        }
+    };
+    using File = std::unique_ptr<std::FILE, FileCloser>;
+
+    inline File open_file(const std::string& path, const char* mode)
+    {
+        File f(std::fopen(path.c_str(), mode));
+        if (!f) throw std::runtime_error("Could not open file: " + path);
+        std::setvbuf(f.get(), nullptr, _IONBF, 0);      // Buffers are managed here, in large blocks
+        return f;
+    }
+
+    // The run files of one external_sort() call: unique names, removed on every exit path
+    class TempRunFiles
+    {
+    public:
+        explicit TempRunFiles(const std::string& temp_dir)
+        {
+            std::string pattern = temp_dir + "/external_sort_XXXXXX";
+            std::vector<char> name(pattern.begin(), pattern.end());
+            name.push_back('\0');
+
+            int fd = ::mkstemp(name.data());
+            if (fd < 0) throw std::runtime_error("Could not create temporary file in: " + temp_dir);
+            ::close(fd);
+            prefix_ = name.data();                      // The empty file reserves the prefix until we are done
+        }
+
+        TempRunFiles(const TempRunFiles&) = delete;
+        TempRunFiles& operator=(const TempRunFiles&) = delete;
+
+        ~TempRunFiles()
+        {
+            for (const auto& path : live_)
+            {
+                std::remove(path.c_str());
+            }
+            std::remove(prefix_.c_str());
+        }
+
+        std::string create()
+        {
+            std::string path = prefix_ + ".run" + std::to_string(counter_++);
+            live_.insert(path);
+            return path;
+        }
+
+        void remove(const std::string& path)
+        {
+            std::remove(path.c_str());
+            live_.erase(path);
+        }
+
+        // The file was renamed away: no longer ours to remove
+        void release(const std::string& path) { live_.erase(path); }
+
+    private:
+        std::string prefix_;
+        std::set<std::string> live_;
+        int counter_ = 0;
+    };
+
+    template <typename T>
+    std::size_t read_block(std::FILE* f, T* data, std::size_t count)
+    {
+        std::size_t got = std::fread(data, sizeof(T), count, f);
+        if (got < count && std::ferror(f)) throw std::runtime_error("Read error during external sort");
+        return got;
+    }
+
+    template <typename T>
+    void write_block(std::FILE* f, const T* data, std::size_t count)
+    {
+        if (std::fwrite(data, sizeof(T), count, f) != count)
+            throw std::runtime_error("Write error during external sort");
+    }
+
+    // Sequential reader that always has the next block in flight
+    template <typename T>
+    class RunReader
+    {
+    public:
+        RunReader(const std::string& path, std::size_t block_elements)
+            : file_(open_file(path, "rb")), current_(block_elements), next_(block_elements)
+        {
+            prefetch();
+        }
+
+        bool next(T& value)
+        {
+            if (position_ == count_ && !advance()) return false;
+            value = current_[position_++];
+            return true;
+        }
+
+    private:
+        File file_;
+        std::vector<T> current_;
+        std::vector<T> next_;
+        std::size_t position_ = 0;
+        std::size_t count_ = 0;
+        std::future<std::size_t> pending_;
+
+        void prefetch()
+        {
+            T* data = next_.data();
+            std::size_t capacity = next_.size();
+            std::FILE* f = file_.get();
+            pending_ = std::async(std::launch::async, [=] { return read_block(f, data, capacity); });
+        }
+
+        bool advance()
+        {
+            if (!pending_.valid()) return false;
+
+            std::size_t got = pending_.get();
+            if (got == 0) return false;
+
+            std::swap(current_, next_);                 // Swaps storage: in-flight pointers stay valid
+            position_ = 0;
+            count_ = got;
+            if (got == next_.size()) prefetch();        // A short block means end of file
+            return true;
+        }
+    };
+
+    // Sequential writer: one buffer fills while the previous one is written in the background
+    template <typename T>
+    class RunWriter
+    {
+    public:
+        RunWriter(const std::string& path, std::size_t block_elements, const char* mode = "wb")
+            : file_(open_file(path, mode)), filling_(block_elements), flushing_(block_elements) {}
+
+        ~RunWriter()
+        {
+            if (pending_.valid()) pending_.wait();      // Never leave a write running on a closed file
+        }
+
+        void push(const T& value)
+        {
+            filling_[count_++] = value;
+            if (count_ == filling_.size()) flush();
+        }
+
+        void close()
+        {
+            flush();
+            wait();
+            if (std::fflush(file_.get()) != 0) throw std::runtime_error("Write error during external sort");
+            file_.reset();
+        }
+
+    private:
+        File file_;
+        std::vector<T> filling_;
+        std::vector<T> flushing_;
+        std::size_t count_ = 0;
+        std::future<void> pending_;
+
+        void wait()
+        {
+            if (pending_.valid()) pending_.get();       // Rethrows a failed write
+        }
+
+        void flush()
+        {
+            if (count_ == 0) return;
+            wait();
+            std::swap(filling_, flushing_);
+            start_write(count_);
+            count_ = 0;
+        }
+
+        void start_write(std::size_t count)
+        {
+            const T* data = flushing_.data();
+            std::FILE* f = file_.get();
+            pending_ = std::async(std::launch::async, [=] { write_block(f, data, count); });
+        }
+    };
+
+    template <typename K>
+    struct Cursor
+    {
+        K key;
+        std::size_t run;
+
+        // Ties broken by run index: earlier runs hold earlier input, so the merge is stable
+        bool operator<(const Cursor& other) const
+        {
+            return key < other.key || (!(other.key < key) && run < other.run);
+        }
+    };
+
+    template <typename T, typename Key>
+    void merge_runs(const std::vector<std::string>& runs, const std::string& output,
+                    std::size_t block_elements, Key& key, const char* mode = "wb")
+    {
+        using K = std::decay_t<decltype(key(std::declval<const T&>()))>;
+
+        std::vector<std::unique_ptr<RunReader<T>>> readers;
+        std::vector<T> heads(runs.size());
+        BinaryHeap<Cursor<K>> heap(static_cast<int>(runs.size()));
+
+        for (std::size_t r = 0; r < runs.size(); ++r)
+        {
+            readers.push_back(std::make_unique<RunReader<T>>(runs[r], block_elements));
+            if (readers[r]->next(heads[r])) heap.insert(Cursor<K>{key(heads[r]), r});
+        }
+
+        RunWriter<T> writer(output, block_elements, mode);
+        while (!heap.isEmpty())
+        {
+            std::size_t r = heap.findMin().run;
+            writer.push(heads[r]);
+
+            if (readers[r]->next(heads[r]))
+                heap.replaceMin(Cursor<K>{key(heads[r]), r});
+            else
+                heap.deleteMin();
+        }
+        writer.close();
+    }
+}
+
+template <typename T, typename Key = identity_key>
+void external_sort(const std::string& input, const std::string& output,
+                   const ExternalSortConfig& config = ExternalSortConfig(), Key key = Key())
+{
+    using namespace external_sort_detail;
+    static_assert(std::is_trivially_copyable<T>::value, "external_sort works on raw binary records");
+
+    if (config.fan_in < 2) throw std::invalid_argument("external_sort needs a fan-in of at least 2");
+
+    // Phase 1: three chunk buffers (reading, sorting, writing) plus the sort's own scratch chunk
+    const std::size_t chunk_elements = std::max<std::size_t>(config.memory_budget / (4 * sizeof(T)), 1);
+
+    // Declared before the phase 1 buffers and futures, so it is destroyed (and removes its
+    // files) only after any write still in flight has finished
+    TempRunFiles run_files(config.temp_dir);
+    std::vector<std::string> runs;
+
+    {
+        std::vector<T> reading(chunk_elements);
+        std::vector<T> sorting(chunk_elements);
+        std::vector<T> writing(chunk_elements);
+
+        File in = open_file(input, "rb");
+        File run_file;
+        // Declared after the buffers and files they use, so they are waited on first
+        std::future<std::size_t> pending_read;
+        std::future<void> pending_write;
+
+        auto start_read = [&]() {
+            T* data = reading.data();
+            std::FILE* f = in.get();
+            pending_read = std::async(std::launch::async, [=] { return read_block(f, data, chunk_elements); });
+        };
+
+        start_read();
+        while (true)
+        {
+            std::size_t count = pending_read.get();
+            if (count == 0) break;
+
+            std::swap(sorting, reading);                // Swaps storage: nothing is in flight on either
+            if (count == chunk_elements) start_read();  // A short chunk means end of file
+
+            key_sort(sorting.begin(), sorting.begin() + static_cast<std::ptrdiff_t>(count), key);
+
+            // The previous run's write overlapped this sort; finish it before reusing its buffer
+            if (pending_write.valid()) pending_write.get();
+            run_file.reset();
+
+            std::swap(sorting, writing);
+            runs.push_back(run_files.create());
+            run_file = open_file(runs.back(), "wbx");   // Never truncate an existing file
+            const T* data = writing.data();
+            std::FILE* f = run_file.get();
+            pending_write = std::async(std::launch::async, [=] { write_block(f, data, count); });
+
+            if (count < chunk_elements) break;
+        }
+        if (pending_write.valid()) pending_write.get();
+    }
+
+    if (runs.empty())
+    {
+        open_file(output, "wb");                        // Empty input: empty output
+        return;
+    }
+
+    // Phase 2: fan_in input buffers and one output buffer, each double-buffered
+    const std::size_t block_elements =
+        std::max<std::size_t>(config.memory_budget / (2 * (config.fan_in + 1) * sizeof(T)), 1);
+
+    while (runs.size() > 1)
+    {
+        bool final_pass = runs.size() <= config.fan_in;
+        std::vector<std::string> merged;
+
+        for (std::size_t first = 0; first < runs.size(); first += config.fan_in)
+        {
+            std::size_t last = std::min(runs.size(), first + config.fan_in);
+            std::vector<std::string> group(runs.begin() + first, runs.begin() + last);
+
+            if (group.size() == 1)
+            {
+                merged.push_back(group.front());        // Nothing to merge with: carry over
+                continue;
+            }
+
+            merged.push_back(final_pass ? output : run_files.create());
+            merge_runs<T>(group, merged.back(), block_elements, key, final_pass ? "wb" : "wbx");
+            for (const auto& run : group)
+            {
+                run_files.remove(run);
+            }
+        }
+        runs = std::move(merged);
+    }
+
+    if (runs.front() != output)
+    {
+        // A single run: it already is the sorted output
+        if (std::rename(runs.front().c_str(), output.c_str()) == 0)
+        {
+            run_files.release(runs.front());
+        }
+        else
+        {
+            merge_runs<T>(runs, output, block_elements, key);
+            run_files.remove(runs.front());
+        }
+    }
+}
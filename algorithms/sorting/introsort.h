@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "block_partition.h"
+
+/**
+ * Introsort Engine
+ * Iterator-based quicksort that cannot go quadratic:
+ * - pivot: median of 3, or Tukey's ninther (median of 3 medians) on large ranges
+ * - recursion depth limited to 2 * log2(n); deeper ranges fall back to heapsort
+ * - ranges below a cutoff are finished with insertion sort
+ * - elements are only ever moved (std::iter_swap / std::move), never copied
+ * - arithmetic keys sorted with std::less use the branchless block partition
+ *   (block_partition.h), chosen at compile time; anything else uses Hoare partitioning
+ *
+ * parallel_introsort() forks the right-hand side of every large partition onto a
+ * set of worker threads and keeps the left-hand side on the current thread.
+ */
+
+namespace introsort_detail
+{
+    constexpr std::ptrdiff_t insertion_sort_cutoff = 16;
+    constexpr std::ptrdiff_t ninther_threshold = 128;
+
+    template <typename RandomIt, typename Compare>
+    void insertion_sort(RandomIt first, RandomIt last, Compare& comp)
+    {
+        if (first == last) return;
+
+        for (RandomIt i = first + 1; i != last; ++i)
+        {
+            auto value = std::move(*i);
+            RandomIt hole = i;
+            for (; hole != first && comp(value, *(hole - 1)); --hole)
+            {
+                *hole = std::move(*(hole - 1));
+            }
+            *hole = std::move(value);
+        }
+    }
+
+    // Percolate the element at hole down a max-heap of size n rooted at first
+    template <typename RandomIt, typename Compare>
+    void sift_down(RandomIt first, std::ptrdiff_t hole, std::ptrdiff_t n, Compare& comp)
+    {
+        auto value = std::move(first[hole]);
+        std::ptrdiff_t child;
+
+        for (; (child = 2 * hole + 1) < n; hole = child)
+        {
+            if (child + 1 < n && comp(first[child], first[child + 1])) ++child;
+            if (!comp(value, first[child])) break;
+            first[hole] = std::move(first[child]);
+        }
+        first[hole] = std::move(value);
+    }
+
+    template <typename RandomIt, typename Compare>
+    void heapsort(RandomIt first, RandomIt last, Compare& comp)
+    {
+        std::ptrdiff_t n = last - first;
+        for (std::ptrdiff_t i = n / 2 - 1; i >= 0; --i)
+        {
+            sift_down(first, i, n, comp);
+        }
+        for (std::ptrdiff_t end = n - 1; end > 0; --end)
+        {
+            std::iter_swap(first, first + end);
+            sift_down(first, 0, end, comp);
+        }
+    }
+
+    // Order *a <= *b <= *c, leaving the median in b
+    template <typename RandomIt, typename Compare>
+    void sort3(RandomIt a, RandomIt b, RandomIt c, Compare& comp)
+    {
+        if (comp(*b, *a)) std::iter_swap(a, b);
+        if (comp(*c, *b))
+        {
+            std::iter_swap(b, c);
+            if (comp(*b, *a)) std::iter_swap(a, b);
+        }
+    }
+
+    // Move the median of 3 (or ninther) to *first; leaves an element >= it in (first, last)
+    template <typename RandomIt, typename Compare>
+    void choose_pivot(RandomIt first, RandomIt last, Compare& comp)
+    {
+        std::ptrdiff_t n = last - first;
+        RandomIt mid = first + n / 2;
+
+        if (n > ninther_threshold)
+        {
+            sort3(first, mid, last - 1, comp);
+            sort3(first + 1, mid - 1, last - 2, comp);
+            sort3(first + 2, mid + 1, last - 3, comp);
+            sort3(mid - 1, mid, mid + 1, comp);
+            std::iter_swap(first, mid);
+        }
+        else
+        {
+            sort3(mid, first, last - 1, comp);
+        }
+    }
+
+    /**
+     * Hoare-partition [first + 1, last) around the pivot at *first.
+     * Returns cut such that [first, cut) <= pivot <= [cut, last), both sides non-empty.
+     * choose_pivot leaves an element >= pivot to the right and the pivot itself on
+     * the left, so the inner scans need no bounds checks.
+     */
+    template <typename RandomIt, typename Compare>
+    RandomIt hoare_partition(RandomIt first, RandomIt last, Compare& comp)
+    {
+        RandomIt low = first + 1;
+        RandomIt high = last;
+        while (true)
+        {
+            while (comp(*low, *first)) ++low;
+            --high;
+            while (comp(*first, *high)) --high;
+            if (!(low < high)) return low;
+            std::iter_swap(low, high);
+            ++low;
+        }
+    }
+
+    template <typename RandomIt>
+    struct Split
+    {
+        RandomIt left_end;                              // Sort [first, left_end)
+        RandomIt right_begin;                           // and [right_begin, last)
+    };
+
+    template <typename RandomIt, typename Compare>
+    using use_block_partition =
+        block_partition_detail::is_less_on_arithmetic<typename std::iterator_traits<RandomIt>::value_type, Compare>;
+
+    /**
+     * Pick a pivot and partition around it.
+     * leftmost is false when *(first - 1) is an upper bound from an earlier partition; if the
+     * pivot equals it, the range is full of duplicates and the equal block is split off whole
+     * (the Hoare scheme already balances duplicates, the block scheme sends them all right).
+     * The block scheme leaves the pivot between the two sides, so *(first - 1) is never part
+     * of a range another thread is sorting.
+     */
+    template <typename RandomIt, typename Compare>
+    Split<RandomIt> partition_range(RandomIt first, RandomIt last, Compare& comp, bool leftmost)
+    {
+        choose_pivot(first, last, comp);
+
+        if constexpr (use_block_partition<RandomIt, Compare>::value)
+        {
+            if (!leftmost && !comp(*(first - 1), *first))
+            {
+                RandomIt pivot = partition_equal(first, last, comp);
+                return Split<RandomIt>{first, pivot + 1};
+            }
+            RandomIt pivot = block_partition(first, last, comp);
+            return Split<RandomIt>{pivot, pivot + 1};
+        }
+        else
+        {
+            (void)leftmost;
+            RandomIt cut = hoare_partition(first, last, comp);
+            return Split<RandomIt>{cut, cut};
+        }
+    }
+
+    // Recurse on the right part, loop on the left, so the stack stays O(log n)
+    template <typename RandomIt, typename Compare>
+    void introsort_loop(RandomIt first, RandomIt last, int depth_limit, Compare& comp, bool leftmost = true)
+    {
+        while (last - first > insertion_sort_cutoff)
+        {
+            if (depth_limit == 0)
+            {
+                heapsort(first, last, comp);
+                return;
+            }
+            --depth_limit;
+
+            Split<RandomIt> split = partition_range(first, last, comp, leftmost);
+            introsort_loop(split.right_begin, last, depth_limit, comp, false);
+            last = split.left_end;
+        }
+        insertion_sort(first, last, comp);
+    }
+
+    inline int depth_limit(std::ptrdiff_t n)
+    {
+        int log2 = 0;
+        while (n > 1)
+        {
+            n >>= 1;
+            ++log2;
+        }
+        return 2 * log2;
+    }
+}
+
+template <typename RandomIt, typename Compare = std::less<>>
+void introsort(RandomIt first, RandomIt last, Compare comp = Compare())
+{
+    introsort_detail::introsort_loop(first, last, introsort_detail::depth_limit(last - first), comp);
+}
+
+/**
+ * Parallel Introsort
+ * Partitions larger than grain_size are split: the right part becomes a task any worker
+ * can pick up, the left part stays on the current thread. Below grain_size (or past the
+ * depth limit) a task finishes sequentially. The calling thread works as well, and the
+ * call returns once every task has completed.
+ * comp must be safe to call concurrently.
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void parallel_introsort(RandomIt first, RandomIt last, Compare comp = Compare(),
+                        unsigned num_threads = std::thread::hardware_concurrency(),
+                        std::ptrdiff_t grain_size = 1 << 14)
+{
+    using namespace introsort_detail;
+
+    grain_size = std::max(grain_size, insertion_sort_cutoff + 1);
+    if (num_threads <= 1 || last - first <= grain_size)
+    {
+        introsort(first, last, comp);
+        return;
+    }
+
+    struct Task
+    {
+        RandomIt first;
+        RandomIt last;
+        int depth_limit;
+        bool leftmost;
+    };
+
+    std::mutex m;
+    std::condition_variable cv;
+    std::deque<Task> tasks{Task{first, last, depth_limit(last - first), true}};
+    size_t pending = 1;                                 // Tasks queued or running
+
+    auto run_task = [&](Task task) {
+        Compare local_comp = comp;
+        while (task.last - task.first > grain_size && task.depth_limit > 0)
+        {
+            --task.depth_limit;
+            Split<RandomIt> split = partition_range(task.first, task.last, local_comp, task.leftmost);
+            {
+                std::lock_guard<std::mutex> lock(m);
+                tasks.push_back(Task{split.right_begin, task.last, task.depth_limit, false});
+                ++pending;
+            }
+            cv.notify_one();
+            task.last = split.left_end;
+        }
+        introsort_loop(task.first, task.last, task.depth_limit, local_comp, task.leftmost);
+    };
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(m);
+        while (true)
+        {
+            cv.wait(lock, [&] { return !tasks.empty() || pending == 0; });
+            if (tasks.empty()) return;                  // pending == 0: everything is sorted
+
+            Task task = tasks.back();                   // LIFO: most recent split is the most cache-warm
+            tasks.pop_back();
+            lock.unlock();
+
+            run_task(task);
+
+            lock.lock();
+            if (--pending == 0) cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < num_threads; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+}
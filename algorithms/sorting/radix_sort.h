@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "introsort.h"
+
+/**
+ * LSD Radix Sort
+ * Stable, O(n * bytes) sort on integer or floating point keys, taken either from
+ * the elements themselves or from a key-extractor functor (e.g. a record field).
+ * - 8-bit digits: one 256-entry histogram per key byte, all built in one read pass
+ * - passes whose histogram puts every element in one bucket are skipped
+ *   (e.g. the high bytes of small integers)
+ * - signed keys have their sign bit flipped, floats are mapped to an unsigned
+ *   ordering (negative: flip all bits, positive: flip the sign bit)
+ *
+ * key_sort() picks the algorithm from the key type at compile time: radix sort for
+ * integer / float / double keys, introsort on key(a) < key(b) for everything else.
+ */
+
+struct identity_key
+{
+    template <typename T>
+    constexpr T&& operator()(T&& value) const noexcept { return std::forward<T>(value); }
+};
+
+namespace radix_sort_detail
+{
+    constexpr int digit_bits = 8;
+    constexpr int buckets = 1 << digit_bits;
+
+    template <typename K>
+    struct is_radix_key
+        : std::bool_constant<(std::is_integral<K>::value && !std::is_same<K, bool>::value) ||
+                             std::is_same<K, float>::value || std::is_same<K, double>::value>
+    {};
+
+    template <typename It, typename Key>
+    using key_type_t = std::decay_t<decltype(std::declval<Key&>()(*std::declval<It&>()))>;
+
+    template <typename K, typename = void>
+    struct radix_traits
+    {
+        using type = std::make_unsigned_t<K>;
+
+        static type to_unsigned(K key)
+        {
+            type bits = static_cast<type>(key);
+            if constexpr (std::is_signed<K>::value)
+                bits ^= type(1) << (sizeof(type) * 8 - 1);
+            return bits;
+        }
+    };
+
+    template <typename K>
+    struct radix_traits<K, std::enable_if_t<std::is_floating_point<K>::value>>
+    {
+        using type = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+
+        static type to_unsigned(K key)
+        {
+            type bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            constexpr type sign = type(1) << (sizeof(type) * 8 - 1);
+            return bits ^ ((bits & sign) ? ~type(0) : sign);
+        }
+    };
+
+    template <typename It, typename Key>
+    std::size_t digit(It it, Key& key, int shift)
+    {
+        using K = key_type_t<It, Key>;
+        return static_cast<std::size_t>((radix_traits<K>::to_unsigned(key(*it)) >> shift) & (buckets - 1));
+    }
+
+    // Stable counting scatter of [src, src + n) into dst by one digit; offsets are consumed
+    template <typename SrcIt, typename DstIt, typename Key>
+    void scatter(SrcIt src, std::ptrdiff_t n, DstIt dst, Key& key, int shift, std::size_t* offsets)
+    {
+        for (std::ptrdiff_t i = 0; i < n; ++i)
+        {
+            std::size_t d = digit(src + i, key, shift);
+            dst[offsets[d]++] = std::move(src[i]);
+        }
+    }
+
+    inline void exclusive_prefix_sum(std::size_t* counts)
+    {
+        std::size_t sum = 0;
+        for (int d = 0; d < buckets; ++d)
+        {
+            std::size_t c = counts[d];
+            counts[d] = sum;
+            sum += c;
+        }
+    }
+
+    template <typename It, typename Key>
+    constexpr int num_passes()
+    {
+        return static_cast<int>(sizeof(key_type_t<It, Key>) * 8 / digit_bits);
+    }
+}
+
+template <typename RandomIt, typename Key = identity_key>
+void radix_sort(RandomIt first, RandomIt last, Key key = Key())
+{
+    using namespace radix_sort_detail;
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    static_assert(is_radix_key<key_type_t<RandomIt, Key>>::value, "radix_sort needs an integer, float or double key");
+
+    constexpr int passes = num_passes<RandomIt, Key>();
+    const std::ptrdiff_t n = last - first;
+    if (n < 2) return;
+
+    // Every histogram in one read pass
+    std::vector<std::array<std::size_t, buckets>> counts(passes);
+    for (auto& c : counts) c.fill(0);
+    for (RandomIt it = first; it != last; ++it)
+    {
+        auto bits = radix_traits<key_type_t<RandomIt, Key>>::to_unsigned(key(*it));
+        for (int p = 0; p < passes; ++p)
+        {
+            counts[p][(bits >> (p * digit_bits)) & (buckets - 1)]++;
+        }
+    }
+
+    std::vector<T> buffer(static_cast<std::size_t>(n));
+    bool in_buffer = false;                             // Which side currently holds the data
+
+    for (int p = 0; p < passes; ++p)
+    {
+        // Every key has the same digit here: the pass would be the identity permutation
+        std::size_t first_digit = in_buffer ? digit(buffer.begin(), key, p * digit_bits)
+                                            : digit(first, key, p * digit_bits);
+        if (counts[p][first_digit] == static_cast<std::size_t>(n))
+            continue;
+
+        exclusive_prefix_sum(counts[p].data());
+        if (in_buffer)
+            scatter(buffer.begin(), n, first, key, p * digit_bits, counts[p].data());
+        else
+            scatter(first, n, buffer.begin(), key, p * digit_bits, counts[p].data());
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer)
+        std::move(buffer.begin(), buffer.end(), first);
+}
+
+/**
+ * Parallel LSD Radix Sort
+ * Each pass: every thread histograms its own contiguous chunk, the per-thread
+ * histograms are combined into (digit, thread) write offsets, then every thread
+ * scatters its chunk. Chunks scatter in thread order within each digit, so the
+ * result is stable and identical to radix_sort().
+ */
+template <typename RandomIt, typename Key = identity_key>
+void parallel_radix_sort(RandomIt first, RandomIt last, Key key = Key(),
+                         unsigned num_threads = std::thread::hardware_concurrency(),
+                         std::ptrdiff_t min_chunk = 1 << 16)
+{
+    using namespace radix_sort_detail;
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    static_assert(is_radix_key<key_type_t<RandomIt, Key>>::value, "radix_sort needs an integer, float or double key");
+
+    constexpr int passes = num_passes<RandomIt, Key>();
+    const std::ptrdiff_t n = last - first;
+
+    num_threads = static_cast<unsigned>(std::min<std::ptrdiff_t>(std::max(1u, num_threads), n / min_chunk));
+    if (num_threads <= 1)
+    {
+        radix_sort(first, last, key);
+        return;
+    }
+
+    std::vector<T> buffer(static_cast<std::size_t>(n));
+    bool in_buffer = false;
+
+    const std::ptrdiff_t chunk = (n + num_threads - 1) / num_threads;
+    std::vector<std::array<std::size_t, buckets>> counts(num_threads);
+
+    // Run body(t, begin, end) for every chunk on its own thread (chunk 0 on the caller)
+    auto for_each_chunk = [&](auto body) {
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < num_threads; ++t)
+        {
+            threads.emplace_back([&, t] { body(t, std::min(n, t * chunk), std::min(n, (t + 1) * chunk)); });
+        }
+        body(0u, std::ptrdiff_t(0), std::min(n, chunk));
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    for (int p = 0; p < passes; ++p)
+    {
+        const int shift = p * digit_bits;
+
+        for_each_chunk([&](unsigned t, std::ptrdiff_t begin, std::ptrdiff_t end) {
+            Key local_key = key;
+            counts[t].fill(0);
+            for (std::ptrdiff_t i = begin; i < end; ++i)
+            {
+                counts[t][in_buffer ? digit(buffer.begin() + i, local_key, shift) : digit(first + i, local_key, shift)]++;
+            }
+        });
+
+        // Skip the pass when one digit holds every element
+        bool trivial = false;
+        for (int d = 0; d < buckets && !trivial; ++d)
+        {
+            std::size_t total = 0;
+            for (unsigned t = 0; t < num_threads; ++t) total += counts[t][d];
+            trivial = total == static_cast<std::size_t>(n);
+        }
+        if (trivial) continue;
+
+        // Offsets in (digit, thread) order
+        std::size_t sum = 0;
+        for (int d = 0; d < buckets; ++d)
+        {
+            for (unsigned t = 0; t < num_threads; ++t)
+            {
+                std::size_t c = counts[t][d];
+                counts[t][d] = sum;
+                sum += c;
+            }
+        }
+
+        for_each_chunk([&](unsigned t, std::ptrdiff_t begin, std::ptrdiff_t end) {
+            Key local_key = key;
+            if (in_buffer)
+                scatter(buffer.begin() + begin, end - begin, first, local_key, shift, counts[t].data());
+            else
+                scatter(first + begin, end - begin, buffer.begin(), local_key, shift, counts[t].data());
+        });
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer)
+        std::move(buffer.begin(), buffer.end(), first);
+}
+
+/**
+ * Sort by key, choosing the algorithm from the key type at compile time:
+ * radix sort (stable) for integer / float / double keys on non-tiny ranges,
+ * introsort on key(a) < key(b) otherwise.
+ */
+template <typename RandomIt, typename Key = identity_key>
+void key_sort(RandomIt first, RandomIt last, Key key = Key())
+{
+    using K = radix_sort_detail::key_type_t<RandomIt, Key>;
+    constexpr std::ptrdiff_t radix_threshold = 256;     // Below this the histograms cost more than they save
+
+    if constexpr (radix_sort_detail::is_radix_key<K>::value)
+    {
+        if (last - first >= radix_threshold)
+        {
+            radix_sort(first, last, key);
+            return;
+        }
+    }
+
+    if constexpr (std::is_same<Key, identity_key>::value)
+        introsort(first, last);
+    else
+        introsort(first, last, [&key](const auto& a, const auto& b) { return key(a) < key(b); });
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+#include "introsort.h"
+#include "radix_sort.h"
+
+/**
+ * Sort Benchmark
+ * Times every sort variant against std::sort (and std::execution::par when the
+ * standard library provides it) on several input shapes, checking each result.
+ *
+ * Build: g++ -std=c++17 -O2 [-mavx2] -pthread sort_benchmark.cpp -o sort_benchmark -ltbb
+ * (libstdc++ runs std::execution::par on TBB; drop -ltbb if it is not installed)
+ */
+
+#if defined(__cpp_lib_parallel_algorithm) && __cpp_lib_parallel_algorithm >= 201603L
+#define HAVE_PARALLEL_STD_SORT 1
+#endif
+
+std::vector<int> make_input(const std::string& shape, size_t n, std::uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<int> v(n);
+
+    if (shape == "random")
+        for (auto& x : v) x = static_cast<int>(rng());
+    else if (shape == "sorted")
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(i);
+    else if (shape == "reversed")
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(n - i);
+    else if (shape == "few_unique")
+        for (auto& x : v) x = static_cast<int>(rng() % 16);
+    else if (shape == "organ_pipe")
+        for (size_t i = 0; i < n; ++i) v[i] = static_cast<int>(i < n / 2 ? i : n - i);
+
+    return v;
+}
+
+// Best of repetitions, in milliseconds; every run sorts a fresh copy
+template <typename Sort>
+double time_sort(const std::vector<int>& input, const std::vector<int>& expected, int repetitions, Sort sort)
+{
+    double best = 1e300;
+    for (int r = 0; r < repetitions; ++r)
+    {
+        std::vector<int> data = input;
+        auto start = std::chrono::high_resolution_clock::now();
+        sort(data);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        if (data != expected)
+        {
+            std::cerr << "Error: incorrect sort result" << std::endl;
+            std::exit(1);
+        }
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+}
+
+// Usage: ./sort_benchmark [n] [repetitions]
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    int repetitions = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    const std::vector<std::string> shapes = {"random", "sorted", "reversed", "few_unique", "organ_pipe"};
+
+#ifdef __AVX2__
+    std::cout << "Block partition kernel: AVX2\n";
+#else
+    std::cout << "Block partition kernel: scalar (build with -mavx2 for the SIMD kernel)\n";
+#endif
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& shape : shapes)
+    {
+        std::vector<int> input = make_input(shape, n, 1234);
+        std::vector<int> expected = input;
+        std::sort(expected.begin(), expected.end());
+
+        std::cout << shape << " (n = " << n << ")\n";
+        std::cout << "  std::sort:           "
+                  << time_sort(input, expected, repetitions, [](auto& v) { std::sort(v.begin(), v.end()); }) << " ms\n";
+#ifdef HAVE_PARALLEL_STD_SORT
+        std::cout << "  std::sort(par):      "
+                  << time_sort(input, expected, repetitions,
+                               [](auto& v) { std::sort(std::execution::par, v.begin(), v.end()); }) << " ms\n";
+#endif
+        // A lambda comparator is not std::less, so this run keeps the classic Hoare partition
+        std::cout << "  introsort (Hoare):   "
+                  << time_sort(input, expected, repetitions,
+                               [](auto& v) { introsort(v.begin(), v.end(), [](int a, int b) { return a < b; }); })
+                  << " ms\n";
+        std::cout << "  introsort (block):   "
+                  << time_sort(input, expected, repetitions, [](auto& v) { introsort(v.begin(), v.end()); }) << " ms\n";
+        std::cout << "  parallel_introsort:  "
+                  << time_sort(input, expected, repetitions,
+                               [](auto& v) { parallel_introsort(v.begin(), v.end()); }) << " ms\n";
+        std::cout << "  radix_sort:          "
+                  << time_sort(input, expected, repetitions, [](auto& v) { radix_sort(v.begin(), v.end()); }) << " ms\n";
+        std::cout << "  parallel_radix_sort: "
+                  << time_sort(input, expected, repetitions,
+                               [](auto& v) { parallel_radix_sort(v.begin(), v.end()); }) << " ms\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,454 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Benchmark Harness
+ * Modules register benchmarks with BENCHMARK(name) { ... }; the runner executes
+ * warmup iterations, then timed repetitions, and reports min / median / p90 / mean /
+ * stddev per benchmark, plus hardware counters (cycles, instructions, cache misses,
+ * branch misses) read through perf_event_open. Where counters are not available
+ * (no PMU, perf_event_paranoid, non-Linux) they are reported as missing and the
+ * timings are unaffected.
+ *
+ * A benchmark body runs once per repetition. Work outside state.start() / state.stop()
+ * (e.g. copying an input) is not measured; without those calls the whole body is timed.
+ */
+
+namespace bench
+{
+    enum Counter { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, NUM_COUNTERS };
+
+    inline const char* counter_name(int c)
+    {
+        static const char* names[NUM_COUNTERS] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+        return names[c];
+    }
+
+    using CounterValues = std::array<double, NUM_COUNTERS>;  // NaN = not available
+
+    /**
+     * Hardware Counters
+     * One perf event per counter, user space only, inherited by threads the
+     * benchmark spawns (their counts are folded in when they are joined).
+     *
+     * When there are more events than hardware counters the kernel time-slices them,
+     * so each event only counts for part of the measured interval. Every count is read
+     * with its enabled and running times at start() and at stop(), and the interval's
+     * count is scaled by its own enabled / running, which puts all four on the same
+     * interval; a counter that did not run during the interval is reported as missing.
+     * The times cannot be reset (PERF_EVENT_IOC_RESET clears only the count), hence
+     * the differences.
+     * (The events are not opened as one perf group: they must be inherited to cover
+     * spawned threads, and group reads of inherited events are not portable across kernels.)
+     */
+    class PerfCounters
+    {
+    public:
+        PerfCounters()
+        {
+            fds_.fill(-1);
+#ifdef __linux__
+            const std::uint64_t configs[NUM_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                         PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+            for (int c = 0; c < NUM_COUNTERS; ++c)
+            {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = configs[c];
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.inherit = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                fds_[c] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator=(const PerfCounters&) = delete;
+
+        ~PerfCounters()
+        {
+#ifdef __linux__
+            for (int fd : fds_)
+            {
+                if (fd >= 0) ::close(fd);
+            }
+#endif
+        }
+
+        bool available() const
+        {
+            return std::any_of(fds_.begin(), fds_.end(), [](int fd) { return fd >= 0; });
+        }
+
+        void start()
+        {
+#ifdef __linux__
+            for (int c = 0; c < NUM_COUNTERS; ++c)
+            {
+                if (fds_[c] < 0) continue;
+                started_[c] = read_counter(fds_[c], baseline_[c]);
+                ::ioctl(fds_[c], PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        CounterValues stop()
+        {
+            CounterValues values;
+            values.fill(std::nan(""));
+#ifdef __linux__
+            for (int c = 0; c < NUM_COUNTERS; ++c)
+            {
+                if (fds_[c] < 0) continue;
+                ::ioctl(fds_[c], PERF_EVENT_IOC_DISABLE, 0);
+
+                Reading end;
+                if (!started_[c] || !read_counter(fds_[c], end)) continue;
+
+                const std::uint64_t running = end.time_running - baseline_[c].time_running;
+                const std::uint64_t enabled = end.time_enabled - baseline_[c].time_enabled;
+                if (running == 0) continue;
+
+                values[c] = static_cast<double>(end.value - baseline_[c].value);
+                if (running < enabled)
+                    values[c] *= static_cast<double>(enabled) / static_cast<double>(running);
+            }
+#endif
+            return values;
+        }
+
+    private:
+        // Layout fixed by read_format: PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING
+        struct Reading
+        {
+            std::uint64_t value = 0, time_enabled = 0, time_running = 0;
+        };
+
+        std::array<int, NUM_COUNTERS> fds_;
+        std::array<Reading, NUM_COUNTERS> baseline_{};  // Read at start(); stop() reports differences
+        std::array<bool, NUM_COUNTERS> started_{};
+
+        static bool read_counter(int fd, Reading& reading)
+        {
+#ifdef __linux__
+            return ::read(fd, &reading, sizeof(reading)) == static_cast<ssize_t>(sizeof(reading));
+#else
+            (void)fd;
+            (void)reading;
+            return false;
+#endif
+        }
+    };
+
+    // Handed to the benchmark body: brackets the measured region
+    class State
+    {
+    public:
+        explicit State(PerfCounters& counters) : counters_(counters) {}
+
+        void start()
+        {
+            started_ = true;
+            counters_.start();
+            begin_ = std::chrono::steady_clock::now();
+        }
+
+        void stop()
+        {
+            auto end = std::chrono::steady_clock::now();
+            values_ = counters_.stop();
+            elapsed_ns_ = std::chrono::duration<double, std::nano>(end - begin_).count();
+            stopped_ = true;
+        }
+
+        // Units of work per repetition (elements sorted, customers simulated, ...) for a throughput column
+        void set_items(double items) { items_ = items; }
+
+        bool started() const { return started_; }
+        bool stopped() const { return stopped_; }
+        double elapsed_ns() const { return elapsed_ns_; }
+        const CounterValues& counters() const { return values_; }
+        double items() const { return items_; }
+
+    private:
+        PerfCounters& counters_;
+        std::chrono::steady_clock::time_point begin_;
+        bool started_ = false;
+        bool stopped_ = false;
+        double elapsed_ns_ = 0.0;
+        CounterValues values_{};
+        double items_ = 0.0;
+    };
+
+    using Function = std::function<void(State&)>;
+
+    struct Benchmark
+    {
+        std::string name;                               // "module/case"
+        Function function;
+    };
+
+    inline std::vector<Benchmark>& registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    struct Registrar
+    {
+        Registrar(std::string name, Function function)
+        {
+            registry().push_back(Benchmark{std::move(name), std::move(function)});
+        }
+    };
+
+    // Do not let the optimiser drop a result
+    template <typename T>
+    inline void do_not_optimize(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct Result
+    {
+        std::string name;
+        int repetitions = 0;
+        double min_ns = 0, median_ns = 0, p90_ns = 0, mean_ns = 0, stddev_ns = 0;
+        double items_per_second = 0;                    // 0 when the benchmark reports no items
+        CounterValues counters{};                       // Medians over repetitions; NaN = not available
+    };
+
+    // Linear interpolation between closest ranks; values must be sorted
+    inline double percentile(const std::vector<double>& sorted, double q)
+    {
+        if (sorted.empty()) return 0.0;
+        double rank = q * static_cast<double>(sorted.size() - 1);
+        std::size_t low = static_cast<std::size_t>(rank);
+        std::size_t high = std::min(low + 1, sorted.size() - 1);
+        return sorted[low] + (sorted[high] - sorted[low]) * (rank - static_cast<double>(low));
+    }
+
+    struct Options
+    {
+        std::string filter;                             // Substring of the benchmark name
+        int warmup = 1;
+        int repetitions = 10;
+        std::string json_path;
+        std::string csv_path;
+        bool list = false;
+    };
+
+    inline Result run_benchmark(const Benchmark& benchmark, const Options& options, PerfCounters& counters)
+    {
+        std::vector<double> times;
+        std::vector<CounterValues> values;
+        double items = 0.0;
+
+        for (int r = 0; r < options.warmup + options.repetitions; ++r)
+        {
+            State state(counters);
+            counters.start();                           // Restarted by state.start() if the body brackets itself
+            auto begin = std::chrono::steady_clock::now();
+            benchmark.function(state);
+            auto end = std::chrono::steady_clock::now();
+            CounterValues whole = counters.stop();
+
+            if (r < options.warmup) continue;
+
+            if (state.stopped())
+            {
+                times.push_back(state.elapsed_ns());
+                values.push_back(state.counters());
+            }
+            else
+            {
+                times.push_back(std::chrono::duration<double, std::nano>(end - begin).count());
+                values.push_back(whole);
+            }
+            items = state.items();
+        }
+
+        Result result;
+        result.name = benchmark.name;
+        result.repetitions = options.repetitions;
+
+        std::vector<double> sorted = times;
+        std::sort(sorted.begin(), sorted.end());
+        result.min_ns = sorted.front();
+        result.median_ns = percentile(sorted, 0.5);
+        result.p90_ns = percentile(sorted, 0.9);
+
+        double sum = 0.0;
+        for (double t : times) sum += t;
+        result.mean_ns = sum / static_cast<double>(times.size());
+        double squares = 0.0;
+        for (double t : times) squares += (t - result.mean_ns) * (t - result.mean_ns);
+        result.stddev_ns = times.size() > 1 ? std::sqrt(squares / static_cast<double>(times.size() - 1)) : 0.0;
+
+        if (items > 0.0 && result.median_ns > 0.0) result.items_per_second = items / (result.median_ns * 1e-9);
+
+        for (int c = 0; c < NUM_COUNTERS; ++c)
+        {
+            std::vector<double> column;
+            for (const auto& v : values)
+            {
+                if (!std::isnan(v[c])) column.push_back(v[c]);
+            }
+            std::sort(column.begin(), column.end());
+            result.counters[c] = column.empty() ? std::nan("") : percentile(column, 0.5);
+        }
+        return result;
+    }
+
+    inline void print_table(const std::vector<Result>& results, std::ostream& out)
+    {
+        out << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14) << "median ms"
+            << std::setw(12) << "p90 ms" << std::setw(10) << "stddev%" << std::setw(14) << "items/s"
+            << std::setw(8) << "IPC" << std::setw(14) << "cache-miss" << std::setw(14) << "branch-miss" << "\n";
+
+        out << std::fixed;
+        for (const auto& r : results)
+        {
+            out << std::left << std::setw(40) << r.name << std::right << std::setprecision(3)
+                << std::setw(14) << r.median_ns * 1e-6 << std::setw(12) << r.p90_ns * 1e-6
+                << std::setprecision(1) << std::setw(10) << (r.mean_ns > 0 ? 100.0 * r.stddev_ns / r.mean_ns : 0.0);
+
+            if (r.items_per_second > 0)
+                out << std::setprecision(0) << std::setw(14) << r.items_per_second;
+            else
+                out << std::setw(14) << "-";
+
+            if (!std::isnan(r.counters[CYCLES]) && !std::isnan(r.counters[INSTRUCTIONS]) && r.counters[CYCLES] > 0)
+                out << std::setprecision(2) << std::setw(8) << r.counters[INSTRUCTIONS] / r.counters[CYCLES];
+            else
+                out << std::setw(8) << "-";
+
+            for (int c : {CACHE_MISSES, BRANCH_MISSES})
+            {
+                if (std::isnan(r.counters[c]))
+                    out << std::setw(14) << "-";
+                else
+                    out << std::setprecision(0) << std::setw(14) << r.counters[c];
+            }
+            out << "\n";
+        }
+    }
+
+    inline std::string json_number(double value)
+    {
+        if (std::isnan(value)) return "null";
+        std::ostringstream out;
+        out << std::setprecision(17) << value;
+        return out.str();
+    }
+
+    inline void write_json(const std::vector<Result>& results, const std::string& path)
+    {
+        std::ofstream out(path);
+        out << "{\n  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            out << "    {\"name\": \"" << r.name << "\", \"repetitions\": " << r.repetitions
+                << ", \"min_ns\": " << json_number(r.min_ns) << ", \"median_ns\": " << json_number(r.median_ns)
+                << ", \"p90_ns\": " << json_number(r.p90_ns) << ", \"mean_ns\": " << json_number(r.mean_ns)
+                << ", \"stddev_ns\": " << json_number(r.stddev_ns)
+                << ", \"items_per_second\": " << json_number(r.items_per_second);
+            for (int c = 0; c < NUM_COUNTERS; ++c)
+            {
+                out << ", \"" << counter_name(c) << "\": " << json_number(r.counters[c]);
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+
+    // Columns shared with bench_compare; empty field = counter not available
+    inline void write_csv(const std::vector<Result>& results, const std::string& path)
+    {
+        std::ofstream out(path);
+        out << "name,repetitions,min_ns,median_ns,p90_ns,mean_ns,stddev_ns,items_per_second";
+        for (int c = 0; c < NUM_COUNTERS; ++c) out << "," << counter_name(c);
+        out << "\n" << std::setprecision(17);
+
+        for (const auto& r : results)
+        {
+            out << r.name << "," << r.repetitions << "," << r.min_ns << "," << r.median_ns << "," << r.p90_ns
+                << "," << r.mean_ns << "," << r.stddev_ns << "," << r.items_per_second;
+            for (int c = 0; c < NUM_COUNTERS; ++c)
+            {
+                out << ",";
+                if (!std::isnan(r.counters[c])) out << r.counters[c];
+            }
+            out << "\n";
+        }
+    }
+
+    inline int run(const Options& options)
+    {
+        std::vector<Benchmark> selected;
+        for (const auto& b : registry())
+        {
+            if (b.name.find(options.filter) != std::string::npos) selected.push_back(b);
+        }
+        std::sort(selected.begin(), selected.end(),
+                  [](const Benchmark& a, const Benchmark& b) { return a.name < b.name; });
+
+        if (options.list)
+        {
+            for (const auto& b : selected) std::cout << b.name << "\n";
+            return 0;
+        }
+
+        PerfCounters counters;
+        if (!counters.available())
+            std::cerr << "Note: hardware counters unavailable (perf_event_open failed); reporting timings only\n";
+
+        std::vector<Result> results;
+        for (const auto& b : selected)
+        {
+            std::cerr << "Running " << b.name << "..." << std::endl;
+            results.push_back(run_benchmark(b, options, counters));
+        }
+
+        print_table(results, std::cout);
+        if (!options.json_path.empty()) write_json(results, options.json_path);
+        if (!options.csv_path.empty()) write_csv(results, options.csv_path);
+        return 0;
+    }
+}
+
+#define BENCH_CONCAT_INNER(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_INNER(a, b)
+
+// BENCHMARK("module/case") { ... state.start(); ... state.stop(); }
+#define BENCHMARK(name)                                                                          \
+    static void BENCH_CONCAT(bench_function_, __LINE__)(bench::State&);                         \
+    static bench::Registrar BENCH_CONCAT(bench_registrar_, __LINE__)(name, BENCH_CONCAT(bench_function_, __LINE__)); \
+    static void BENCH_CONCAT(bench_function_, __LINE__)([[maybe_unused]] bench::State& state)
@@ -0,0 +1,145 @@
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Benchmark Regression Compare
+ * Reads two CSV files written by bench --csv (baseline, then candidate) and
+ * compares every benchmark present in both on its median time, and on cycles /
+ * instructions when both runs recorded them. A benchmark regresses when its
+ * candidate median is more than threshold percent slower than the baseline.
+ *
+ * Build: g++ -std=c++17 -O2 bench_compare.cpp -o bench_compare
+ * Usage: ./bench_compare baseline.csv candidate.csv [threshold_percent = 5]
+ * Exit status: 0 = no regression, 1 = at least one regression, 2 = bad input
+ */
+
+struct Row
+{
+    std::map<std::string, double> fields;               // Column -> value; missing / empty fields are absent
+};
+
+std::vector<std::string> split(const std::string& line)
+{
+    std::vector<std::string> cells;
+    std::stringstream stream(line);
+    std::string cell;
+    while (std::getline(stream, cell, ',')) cells.push_back(cell);
+    if (!line.empty() && line.back() == ',') cells.push_back("");
+    return cells;
+}
+
+bool read_csv(const std::string& path, std::map<std::string, Row>& rows, std::vector<std::string>& order)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Error: Could not open file: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line))
+    {
+        std::cerr << "Error: Empty file: " << path << std::endl;
+        return false;
+    }
+    std::vector<std::string> header = split(line);
+    if (header.empty() || header[0] != "name")
+    {
+        std::cerr << "Error: Not a benchmark CSV: " << path << std::endl;
+        return false;
+    }
+
+    while (std::getline(file, line))
+    {
+        if (line.empty()) continue;
+        std::vector<std::string> cells = split(line);
+        Row row;
+        for (size_t c = 1; c < cells.size() && c < header.size(); ++c)
+        {
+            if (!cells[c].empty()) row.fields[header[c]] = std::strtod(cells[c].c_str(), nullptr);
+        }
+        order.push_back(cells[0]);
+        rows[cells[0]] = row;
+    }
+    return true;
+}
+
+double field(const Row& row, const std::string& column)
+{
+    auto it = row.fields.find(column);
+    return it == row.fields.end() ? std::nan("") : it->second;
+}
+
+// Percent change from baseline to candidate (positive = larger), NaN if either is missing
+double change(const Row& baseline, const Row& candidate, const std::string& column)
+{
+    auto b = baseline.fields.find(column);
+    auto c = candidate.fields.find(column);
+    if (b == baseline.fields.end() || c == candidate.fields.end() || b->second <= 0.0) return std::nan("");
+    return 100.0 * (c->second - b->second) / b->second;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " baseline.csv candidate.csv [threshold_percent]" << std::endl;
+        return 2;
+    }
+    double threshold = argc > 3 ? std::atof(argv[3]) : 5.0;
+
+    std::map<std::string, Row> baseline, candidate;
+    std::vector<std::string> baseline_order, candidate_order;
+    if (!read_csv(argv[1], baseline, baseline_order) || !read_csv(argv[2], candidate, candidate_order)) return 2;
+
+    int regressions = 0;
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(14) << "base ms"
+              << std::setw(14) << "new ms" << std::setw(10) << "time %" << std::setw(10) << "cycles %"
+              << std::setw(10) << "instr %" << "\n";
+    std::cout << std::fixed;
+
+    for (const auto& name : baseline_order)
+    {
+        auto it = candidate.find(name);
+        if (it == candidate.end())
+        {
+            std::cout << std::left << std::setw(40) << name << "  (missing from candidate)\n";
+            continue;
+        }
+        const Row& b = baseline[name];
+        const Row& c = it->second;
+
+        double time = change(b, c, "median_ns");
+        bool regressed = !std::isnan(time) && time > threshold;
+        regressions += regressed;
+
+        std::cout << std::left << std::setw(40) << name << std::right << std::setprecision(3)
+                  << std::setw(14) << field(b, "median_ns") * 1e-6 << std::setw(14) << field(c, "median_ns") * 1e-6
+                  << std::setprecision(1);
+        for (double percent : {time, change(b, c, "cycles"), change(b, c, "instructions")})
+        {
+            if (std::isnan(percent))
+                std::cout << std::setw(10) << "-";
+            else
+                std::cout << std::showpos << std::setw(10) << percent << std::noshowpos;
+        }
+        std::cout << (regressed ? "  REGRESSION" : "") << "\n";
+    }
+
+    for (const auto& name : candidate_order)
+    {
+        if (baseline.find(name) == baseline.end())
+            std::cout << std::left << std::setw(40) << name << "  (new in candidate)\n";
+    }
+
+    std::cout << regressions << " regression(s) above " << threshold << "%" << std::endl;
+    return regressions > 0 ? 1 : 0;
+}
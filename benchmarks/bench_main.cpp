@@ -0,0 +1,61 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "bench.h"
+
+/**
+ * Benchmark Runner
+ * Runs every benchmark registered by the files in modules/.
+ *
+ * Build (from benchmarks/):
+ *   g++ -std=c++17 -O2 -march=native -pthread bench_main.cpp $(find modules -name '*.cpp') -o bench -ltbb
+ *
+ * Usage: ./bench [--filter substring] [--reps n] [--warmup n] [--json file] [--csv file] [--list]
+ * Compare two runs with bench_compare (see bench_compare.cpp).
+ */
+
+int main(int argc, char* argv[])
+{
+    bench::Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "Error: " << arg << " needs a value" << std::endl;
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--filter")
+            options.filter = value();
+        else if (arg == "--reps")
+            options.repetitions = std::atoi(value().c_str());
+        else if (arg == "--warmup")
+            options.warmup = std::atoi(value().c_str());
+        else if (arg == "--json")
+            options.json_path = value();
+        else if (arg == "--csv")
+            options.csv_path = value();
+        else if (arg == "--list")
+            options.list = true;
+        else
+        {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--filter substring] [--reps n] [--warmup n] [--json file] [--csv file] [--list]" << std::endl;
+            return 2;
+        }
+    }
+
+    if (options.repetitions < 1 || options.warmup < 0)
+    {
+        std::cerr << "Error: need --reps >= 1 and --warmup >= 0" << std::endl;
+        return 2;
+    }
+
+    return bench::run(options);
+}
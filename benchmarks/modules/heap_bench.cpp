@@ -0,0 +1,49 @@
+#include <random>
+#include <vector>
+
+#include "../bench.h"
+#include "../../data_structures/heap/binHeap.h"
+
+namespace
+{
+    const int num_items = 1 << 20;
+
+    std::vector<int> random_keys()
+    {
+        std::mt19937 rng(42);
+        std::vector<int> keys(num_items);
+        for (auto& k : keys) k = static_cast<int>(rng());
+        return keys;
+    }
+}
+
+BENCHMARK("heap/insert_delete_min")
+{
+    static const std::vector<int> keys = random_keys();
+    BinaryHeap<int> heap(num_items);
+
+    state.start();
+    for (int k : keys) heap.insert(k);
+    long long sum = 0;
+    while (!heap.isEmpty())
+    {
+        sum += heap.findMin();
+        heap.deleteMin();
+    }
+    state.stop();
+
+    bench::do_not_optimize(sum);
+    state.set_items(num_items);
+}
+
+BENCHMARK("heap/build_heap")
+{
+    static const std::vector<int> keys = random_keys();
+
+    state.start();
+    BinaryHeap<int> heap(keys);
+    state.stop();
+
+    bench::do_not_optimize(heap.findMin());
+    state.set_items(num_items);
+}
@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../bench.h"
+#include "../../algorithms/dynamic_programming/knapsack/0_1_memotopdown_parallel.h"
+#include "../../algorithms/dynamic_programming/knapsack/0_1_bitset.h"
+
+namespace
+{
+    // Deterministic synthetic instance, so results do not depend on the working directory
+    struct Instance
+    {
+        int n = 200;
+        int capacity = 20000;
+        std::vector<int> weights;
+        std::vector<int> values;
+
+        Instance()
+        {
+            std::mt19937 rng(7);
+            std::uniform_int_distribution<int> weight(1, 500);
+            std::uniform_int_distribution<int> value(1, 1000);
+            for (int i = 0; i < n; ++i)
+            {
+                weights.push_back(weight(rng));
+                values.push_back(value(rng));
+            }
+        }
+    };
+
+    const Instance& instance()
+    {
+        static const Instance instance;
+        return instance;
+    }
+
+    void run_knapsack(bench::State& state, size_t num_threads)
+    {
+        const Instance& instance = ::instance();
+        ThreadPool pool(num_threads);
+
+        state.start();
+        int best = parallel_knapsack(instance.n, instance.capacity, instance.weights, instance.values, pool);
+        state.stop();
+
+        bench::do_not_optimize(best);
+        state.set_items(static_cast<double>(instance.n) * instance.capacity);     // DP cells
+    }
+}
+
+BENCHMARK("knapsack/parallel_1_thread") { run_knapsack(state, 1); }
+BENCHMARK("knapsack/parallel_all_threads") { run_knapsack(state, std::max(1u, std::thread::hardware_concurrency())); }
+
+// Same weights as a subset-sum query: one bit per capacity instead of an int per cell
+BENCHMARK("knapsack/bitset_subset_sum")
+{
+    const Instance& instance = ::instance();
+
+    state.start();
+    int best = bitset_knapsack(instance.n, instance.capacity, instance.weights, instance.weights);
+    state.stop();
+
+    bench::do_not_optimize(best);
+    state.set_items(static_cast<double>(instance.n) * instance.capacity);
+}
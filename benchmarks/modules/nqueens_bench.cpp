@@ -0,0 +1,21 @@
+#include <stdexcept>
+
+#include "../bench.h"
+#include "../../algorithms/parallel/hierarchical_NQueens.h"
+
+namespace
+{
+    void count_queens(bench::State& state, int n, int expected)
+    {
+        NQueensSolver solver(n);
+
+        state.start();
+        int solutions = solver.count_solutions();
+        state.stop();
+
+        if (solutions != expected) throw std::runtime_error("N-Queens benchmark: wrong solution count");
+    }
+}
+
+BENCHMARK("nqueens/n8") { count_queens(state, 8, 92); }
+BENCHMARK("nqueens/n10") { count_queens(state, 10, 724); }
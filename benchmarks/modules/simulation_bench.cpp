@@ -0,0 +1,32 @@
+#include <memory_resource>
+
+#include "../bench.h"
+#include "../../data_structures/heap/event_simulation.h"
+
+namespace
+{
+    const unsigned long long num_customers = 200000;
+
+    // Arrival rate 0.9 per tick against 1 / mean_service per teller: a busy, but stable, queue
+    void run_bank(bench::State& state, std::pmr::memory_resource* arena)
+    {
+        PoissonArrivalSource source(0.9, 3.0, num_customers, 2024, arena);
+        Simulation simulation(4, arena);
+
+        state.start();
+        simulation.run(source);
+        state.stop();
+
+        bench::do_not_optimize(simulation.get_statistics().total_wait_time);
+        state.set_items(static_cast<double>(num_customers));
+    }
+}
+
+BENCHMARK("simulation/bank_default_allocator") { run_bank(state, std::pmr::get_default_resource()); }
+
+// As in simulation_replications: one private, unsynchronised pool per run
+BENCHMARK("simulation/bank_pool_arena")
+{
+    std::pmr::unsynchronized_pool_resource arena;
+    run_bank(state, &arena);
+}
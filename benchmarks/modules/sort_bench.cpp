@@ -0,0 +1,44 @@
+#include <algorithm>
+#include <stdexcept>
+#include <random>
+#include <vector>
+
+#include "../bench.h"
+#include "../../algorithms/sorting/introsort.h"
+#include "../../algorithms/sorting/radix_sort.h"
+
+namespace
+{
+    const size_t num_elements = 1 << 20;
+
+    const std::vector<int>& random_input()
+    {
+        static const std::vector<int> input = [] {
+            std::mt19937 rng(1234);
+            std::vector<int> v(num_elements);
+            for (auto& x : v) x = static_cast<int>(rng());
+            return v;
+        }();
+        return input;
+    }
+
+    // Only the sort is timed, not the copy of the input
+    template <typename Sort>
+    void time_sort(bench::State& state, Sort sort)
+    {
+        std::vector<int> data = random_input();
+
+        state.start();
+        sort(data);
+        state.stop();
+
+        if (!std::is_sorted(data.begin(), data.end())) throw std::runtime_error("Sort benchmark: result not sorted");
+        state.set_items(static_cast<double>(num_elements));
+    }
+}
+
+BENCHMARK("sort/std_sort") { time_sort(state, [](auto& v) { std::sort(v.begin(), v.end()); }); }
+BENCHMARK("sort/introsort") { time_sort(state, [](auto& v) { introsort(v.begin(), v.end()); }); }
+BENCHMARK("sort/parallel_introsort") { time_sort(state, [](auto& v) { parallel_introsort(v.begin(), v.end()); }); }
+BENCHMARK("sort/radix_sort") { time_sort(state, [](auto& v) { radix_sort(v.begin(), v.end()); }); }
+BENCHMARK("sort/parallel_radix_sort") { time_sort(state, [](auto& v) { parallel_radix_sort(v.begin(), v.end()); }); }
@@ -0,0 +1,57 @@
+#include <thread>
+#include <vector>
+
+#include "../bench.h"
+#include "../../data_structures/stack/threadsafe_stack.h"
+
+namespace
+{
+    const int num_operations = 1 << 18;
+}
+
+BENCHMARK("stack/push_pop_single_thread")
+{
+    threadsafe_stack<int> stack;
+
+    state.start();
+    for (int i = 0; i < num_operations; ++i) stack.push(i);
+    long long sum = 0;
+    int value = 0;
+    for (int i = 0; i < num_operations; ++i)
+    {
+        stack.pop(value);
+        sum += value;
+    }
+    state.stop();
+
+    bench::do_not_optimize(sum);
+    state.set_items(2.0 * num_operations);
+}
+
+// Every thread alternates push / pop on the one stack: measures lock contention
+BENCHMARK("stack/push_pop_contended_4_threads")
+{
+    const int num_threads = 4;
+    threadsafe_stack<int> stack;
+
+    state.start();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&stack] {
+            int value = 0;
+            for (int i = 0; i < num_operations / num_threads; ++i)
+            {
+                stack.push(i);
+                stack.pop(value);               // Never empty: this thread's own push precedes it
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    state.stop();
+
+    state.set_items(2.0 * num_operations);
+}
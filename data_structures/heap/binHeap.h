@@ -1,14 +1,52 @@
+#pragma once
+
+#include <exception>
+#include <utility>
 #include <vector>
 
+struct UnderflowException : std::exception
+{
+    const char *what() const noexcept override
+    {
+        return "Heap is empty.";
+    }
+};
+
 template <typename Comparable>
 class BinaryHeap
 {
 public:
-    explicit BinaryHeap(int capacity = 100);
-    explicit BinaryHeap(const vector<Comparable> &items);
+    explicit BinaryHeap(int capacity = 100)
+        : current_size_{0}, array(capacity + 1) {}
+
+    explicit BinaryHeap(const std::vector<Comparable> &items)
+        : current_size_{static_cast<int>(items.size())}, array(items.size() + 10)
+    {
+        for (int i = 0; i < static_cast<int>(items.size()); ++i)
+            array[i + 1] = items[i];
+        buildHeap();
+    }
+
+    bool isEmpty() const
+    {
+        return current_size_ == 0;
+    }
+
+    int size() const
+    {
+        return current_size_;
+    }
 
-    bool isEmpty() const;
-    const Comparable &findMin() const;
+    /**
+     * Return the smallest item
+     * Throws UnderflowException if empty
+     */
+    const Comparable &findMin() const
+    {
+        if (isEmpty())
+            throw UnderflowException{};
+        return array[1];
+    }
 
     /**
      * Insert item x, allowing duplicates
@@ -16,11 +54,11 @@ public:
 
     void insert(const Comparable &x)
     {
-        if (currentSize == array.size() - 1)
-            array.resize(array.resize() * 2);
+        if (current_size_ == static_cast<int>(array.size()) - 1)
+            array.resize(array.size() * 2);
 
         // Percolate Up
-        int hole = ++currentSize;
+        int hole = ++current_size_;
         Comparable copy = x;
 
         /* Put in 0 to prevent doing an explicit test to test if hole is 1
@@ -47,15 +85,6 @@ public:
         if (isEmpty())
             throw UnderflowException{};
 
-        /** Move the minimum element (root of the heap) to minItem.
-         * array[1] contains the minimum element of the heap, as the binary heap property ensures the
-         * smallest element is always at the root. std::move(array[1]) casts array[1] to an rvalue reference,
-         * allowing for the move assignment operator to be used. This means the value of array[1] is moved to
-         * minItem, and array[1] is left in a valid but unspecified state.
-         */
-
-        Comparable minItem = std::move(array[1]);
-
         /** Move the last element in the heap to the root position.
          * current_size_ is the index of the last element in the heap.
          * array[current_size_--] accesses the last element in the heap and then decrements current_size_ by 1,
@@ -84,13 +113,41 @@ public:
         array[1] = std::move(array[current_size_--]);
         percolateDown(1);
     }
-    void makeEmpty();
+
+    /**
+     * Replace the minimum item with x
+     * Equivalent to deleteMin() followed by insert(x), with a single percolate down
+     * (the usual step of a k-way merge: pop a run's head, push its successor)
+     * Throws UnderflowException if empty
+     */
+    void replaceMin(const Comparable &x)
+    {
+        if (isEmpty())
+            throw UnderflowException{};
+
+        array[1] = x;
+        percolateDown(1);
+    }
+
+    void makeEmpty()
+    {
+        current_size_ = 0;
+    }
 
 private:
     int current_size_;        // number of elements in heap
     std::vector<Comparable> array; // the heap array
 
-    void buildHeap();
+    /**
+     * Establish heap order property from an arbitrary arrangement of items
+     * Runs in linear time
+     */
+    void buildHeap()
+    {
+        for (int i = current_size_ / 2; i > 0; --i)
+            percolateDown(i);
+    }
+
     // Hole:
     void percolateDown(int hole)
     {
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <memory_resource>
+#include <deque>
+#include <functional>
+#include <limits>
+
+#include "sim_statistics.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Simulation clock: 64-bit so long runs cannot wrap the tick counter
+using Tick = long long;
+
+// Customer Class
+class Customer {
+public:
+    Tick arrival_time;
+    Tick service_time;
+
+    Customer(Tick arrival, Tick service)
+        : arrival_time(arrival), service_time(service) {}
+};
+
+/**
+ * Arrival Source
+ * Pull-based stream of customers in non-decreasing arrival_time order.
+ * The simulation only asks for the next customer once the previous arrival
+ * has been processed, so at most one ARRIVAL event is ever in the event queue.
+ */
+class ArrivalSource {
+public:
+    virtual ~ArrivalSource() = default;
+
+    // Next customer, or nullptr once the source is exhausted
+    virtual std::shared_ptr<Customer> next() = 0;
+};
+
+// Replays a pre-built customer list (sorted by arrival time up front)
+class VectorArrivalSource : public ArrivalSource {
+public:
+    explicit VectorArrivalSource(std::vector<std::shared_ptr<Customer>> customers)
+        : customers(std::move(customers)), position(0)
+    {
+        std::stable_sort(this->customers.begin(), this->customers.end(),
+                         [](const std::shared_ptr<Customer>& a, const std::shared_ptr<Customer>& b) {
+                             return a->arrival_time < b->arrival_time;
+                         });
+    }
+
+    std::shared_ptr<Customer> next() override {
+        if (position == customers.size()) return nullptr;
+        return customers[position++];
+    }
+
+private:
+    std::vector<std::shared_ptr<Customer>> customers;
+    size_t position;
+};
+
+/**
+ * Synthetic Poisson source: exponential inter-arrival and service times,
+ * rounded up to whole ticks (service takes at least one tick).
+ * Generates customers lazily, so num_customers can be arbitrarily large.
+ */
+class PoissonArrivalSource : public ArrivalSource {
+public:
+    PoissonArrivalSource(double arrival_rate, double mean_service, unsigned long long num_customers,
+                         std::uint64_t seed = 1,
+                         std::pmr::memory_resource* arena = std::pmr::get_default_resource())
+        : interarrival(arrival_rate), service(1.0 / mean_service),
+          remaining(num_customers), clock(0.0), rng(seed), allocator(arena) {}
+
+    std::shared_ptr<Customer> next() override {
+        if (remaining == 0) return nullptr;
+        --remaining;
+
+        clock += interarrival(rng);
+        Tick arrival = static_cast<Tick>(clock);
+        Tick service_time = std::max<Tick>(1, static_cast<Tick>(std::ceil(service(rng))));
+        return std::allocate_shared<Customer>(allocator, arrival, service_time);
+    }
+
+private:
+    std::exponential_distribution<double> interarrival;
+    std::exponential_distribution<double> service;
+    unsigned long long remaining;
+    double clock;
+    std::mt19937_64 rng;
+    std::pmr::polymorphic_allocator<Customer> allocator;   // Customer storage (and control blocks)
+};
+
+/**
+ * Trace file source: text file of "<arrival_time> <service_time>" pairs,
+ * one customer per line, sorted by arrival time. Any other content (signs,
+ * stray characters, a missing or extra field, values beyond Tick) throws.
+ * The file is mmap'ed read-only and parsed in place; the kernel pages it in
+ * sequentially, so traces larger than RAM are fine.
+ */
+class TraceArrivalSource : public ArrivalSource {
+public:
+    explicit TraceArrivalSource(const std::string& path)
+        : data(nullptr), size(0), cursor(0), last_arrival(0)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Could not open trace file: " + path);
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Could not stat trace file: " + path);
+        }
+
+        size = static_cast<size_t>(st.st_size);
+        if (size > 0) {
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Could not mmap trace file: " + path);
+            }
+            data = static_cast<const char*>(mapping);
+            ::madvise(mapping, size, MADV_SEQUENTIAL);
+        }
+        ::close(fd);                                    // Mapping stays valid after close
+    }
+
+    TraceArrivalSource(const TraceArrivalSource&) = delete;
+    TraceArrivalSource& operator=(const TraceArrivalSource&) = delete;
+
+    ~TraceArrivalSource() override {
+        if (data) ::munmap(const_cast<char*>(data), size);
+    }
+
+    std::shared_ptr<Customer> next() override {
+        skip_whitespace(true);
+        if (cursor == size) return nullptr;
+
+        Tick arrival, service_time;
+        read_number(arrival);
+        skip_whitespace(false);
+        if (cursor == size || data[cursor] == '\n')
+            fail("missing service time");
+        read_number(service_time);
+
+        // Nothing but whitespace may follow on the line
+        skip_whitespace(false);
+        if (cursor < size && data[cursor] != '\n')
+            fail("more than two numbers");
+
+        if (arrival < last_arrival)
+            throw std::runtime_error("Trace file is not sorted by arrival time");
+        last_arrival = arrival;
+
+        return std::make_shared<Customer>(arrival, service_time);
+    }
+
+private:
+    const char* data;
+    size_t size;
+    size_t cursor;
+    Tick last_arrival;
+    long long line = 1;                                 // For error messages
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("Malformed trace file, line " + std::to_string(line) + ": " + what);
+    }
+
+    // Skip blanks; newlines too only when across_lines is set
+    void skip_whitespace(bool across_lines) {
+        while (cursor < size) {
+            char c = data[cursor];
+            if (c == '\n') {
+                if (!across_lines) return;
+                line++;
+            } else if (c != ' ' && c != '\t' && c != '\r') {
+                return;
+            }
+            cursor++;
+        }
+    }
+
+    // Parse a non-negative integer that must end at whitespace or end of file
+    void read_number(Tick& value) {
+        if (data[cursor] < '0' || data[cursor] > '9')
+            fail(std::string("unexpected character '") + data[cursor] + "'");
+
+        value = 0;
+        while (cursor < size && data[cursor] >= '0' && data[cursor] <= '9') {
+            int digit = data[cursor] - '0';
+            if (value > (std::numeric_limits<Tick>::max() - digit) / 10)
+                fail("number out of range");
+            value = value * 10 + digit;
+            cursor++;
+        }
+
+        if (cursor < size && data[cursor] != ' ' && data[cursor] != '\t' && data[cursor] != '\r' && data[cursor] != '\n')
+            fail(std::string("unexpected character '") + data[cursor] + "'");
+    }
+};
+
+// Event Type Enum
+enum class EventType { ARRIVAL, DEPARTURE };
+
+// Event Class
+class Event {
+public:
+    EventType type;
+    Tick time;
+    std::shared_ptr<Customer> customer;
+
+    Event(EventType type, Tick time, std::shared_ptr<Customer> customer = nullptr)
+        : type(type), time(time), customer(customer) {}
+
+    bool operator<(const Event& other) const {
+        return time > other.time; // Reverse for priority queue (min-heap)
+    }
+};
+
+// Simulation Class
+class Simulation {
+public:
+    struct Statistics {
+        Tick total_wait_time = 0;
+        long long num_customers = 0;
+        long long max_line_length = 0;
+
+        // O(1) per event, constant memory: no per-customer records are kept
+        LogHistogram<> wait_times;                      // Wait (arrival -> service start) per customer
+        TimeWeightedAverage line_length;                // Customers in the waiting line over time
+        TimeWeightedAverage busy_tellers;               // Tellers serving over time
+        Tick end_time = 0;                              // Clock value the averages are taken at
+        int num_tellers = 0;
+
+        double average_wait_time() const {
+            return num_customers ? static_cast<double>(total_wait_time) / num_customers : 0.0;
+        }
+        double average_line_length() const { return line_length.average(end_time); }
+        double utilization() const { return num_tellers ? busy_tellers.average(end_time) / num_tellers : 0.0; }
+    };
+
+    using CheckpointCallback = std::function<void(const Statistics&)>;
+
+    // All queues allocate from arena, so independent runs can each own a private pool
+    Simulation(int num_tellers, std::pmr::memory_resource* arena = std::pmr::get_default_resource())
+        : num_tellers(num_tellers), current_time(0), tellers(num_tellers, nullptr),
+          event_queue(std::less<Event>(), std::pmr::vector<Event>(arena)),
+          waiting_queue(std::pmr::deque<std::shared_ptr<Customer>>(arena)),
+          arrivals(nullptr), busy_tellers(0), checkpoint_interval(0), next_checkpoint(0)
+    {
+        statistics.num_tellers = num_tellers;
+    }
+
+    // Report a statistics snapshot every interval ticks of simulated time
+    // (interval <= 0 or an empty callback disables)
+    void set_checkpoint(Tick interval, CheckpointCallback callback) {
+        on_checkpoint = std::move(callback);
+        checkpoint_interval = on_checkpoint ? interval : 0;
+        next_checkpoint = current_time + interval;
+    }
+
+    void schedule_event(const Event& event) {
+        event_queue.push(event);
+    }
+
+    void process_event(const Event& event) {
+        while (checkpoint_interval > 0 && next_checkpoint <= event.time) {
+            statistics.end_time = next_checkpoint;
+            on_checkpoint(statistics);
+            next_checkpoint += checkpoint_interval;
+        }
+
+        current_time = event.time;
+        statistics.end_time = current_time;
+
+        if (event.type == EventType::ARRIVAL) {
+            process_arrival(event.customer);
+        } else if (event.type == EventType::DEPARTURE) {
+            process_departure(event.customer);
+        }
+    }
+
+    void process_arrival(const std::shared_ptr<Customer>& customer) {
+        statistics.num_customers++;
+        schedule_next_arrival();
+        int available_teller = find_available_teller();
+
+        if (available_teller != -1) {
+            assign_teller(available_teller, customer);
+        } else {
+            waiting_queue.push(customer);
+            long long line = static_cast<long long>(waiting_queue.size());
+            statistics.max_line_length = std::max(statistics.max_line_length, line);
+            statistics.line_length.update(current_time, line);
+        }
+    }
+
+    void process_departure(const std::shared_ptr<Customer>& customer) {
+        release_teller(customer);
+
+        if (!waiting_queue.empty()) {
+            auto next_customer = waiting_queue.front();
+            waiting_queue.pop();
+            statistics.line_length.update(current_time, static_cast<long long>(waiting_queue.size()));
+            assign_teller(find_available_teller(), next_customer);
+        }
+    }
+
+    int find_available_teller() {
+        for (int i = 0; i < num_tellers; ++i) {
+            if (!tellers[i]) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void assign_teller(int teller_index, const std::shared_ptr<Customer>& customer) {
+        tellers[teller_index] = customer;
+        Tick departure_time = current_time + customer->service_time;
+        schedule_event(Event(EventType::DEPARTURE, departure_time, customer));
+        Tick wait = current_time - customer->arrival_time;
+        statistics.total_wait_time += wait;
+        statistics.wait_times.record(static_cast<std::uint64_t>(wait));
+        statistics.busy_tellers.update(current_time, ++busy_tellers);
+    }
+
+    void release_teller(const std::shared_ptr<Customer>& customer) {
+        for (int i = 0; i < num_tellers; ++i) {
+            if (tellers[i] == customer) {
+                tellers[i] = nullptr;
+                statistics.busy_tellers.update(current_time, --busy_tellers);
+                break;
+            }
+        }
+    }
+
+    // Pull the next customer from the arrival source, if any, and schedule its arrival
+    void schedule_next_arrival() {
+        auto customer = arrivals->next();
+        if (customer) {
+            schedule_event(Event(EventType::ARRIVAL, customer->arrival_time, customer));
+        }
+    }
+
+    void run_simulation(const std::vector<std::shared_ptr<Customer>>& customers) {
+        VectorArrivalSource source(customers);
+        run_simulation(source);
+    }
+
+    void run_simulation(ArrivalSource& source) {
+        run(source);
+        print_statistics();
+    }
+
+    // Only the next arrival is ever queued, so the event queue holds at most
+    // num_tellers + 1 events regardless of how many customers the source yields
+    void run(ArrivalSource& source) {
+        arrivals = &source;
+        schedule_next_arrival();
+
+        while (!event_queue.empty()) {
+            auto event = event_queue.top();
+            event_queue.pop();
+            process_event(event);
+        }
+
+        arrivals = nullptr;
+    }
+
+    const Statistics& get_statistics() const { return statistics; }
+
+    void print_statistics() const {
+        print_statistics(statistics);
+    }
+
+    static void print_statistics(const Statistics& stats) {
+        std::cout << "Average wait time: " << stats.average_wait_time() << " ticks\n";
+        std::cout << "Wait time p50/p99/p999: " << stats.wait_times.percentile(0.50) << " / "
+                  << stats.wait_times.percentile(0.99) << " / " << stats.wait_times.percentile(0.999) << " ticks\n";
+        std::cout << "Max line length: " << stats.max_line_length << " customers\n";
+        std::cout << "Average line length: " << stats.average_line_length() << " customers\n";
+        std::cout << "Teller utilization: " << stats.utilization() * 100.0 << " %\n";
+    }
+
+private:
+    int num_tellers;
+    Tick current_time;
+    std::vector<std::shared_ptr<Customer>> tellers;
+    std::priority_queue<Event, std::pmr::vector<Event>> event_queue;
+    std::queue<std::shared_ptr<Customer>, std::pmr::deque<std::shared_ptr<Customer>>> waiting_queue;
+    ArrivalSource* arrivals;                            // Non-owning; set for the duration of run_simulation
+    long long busy_tellers;
+    Statistics statistics;
+
+    Tick checkpoint_interval;
+    Tick next_checkpoint;
+    CheckpointCallback on_checkpoint;
+};
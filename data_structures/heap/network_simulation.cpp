@@ -0,0 +1,523 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+
+#include "sim_statistics.h"
+
+/**
+ * Network of Queues: Sequential and Conservative Parallel Engines
+ *
+ * A network of multi-teller service stations. Customers arrive from outside at every
+ * station, are served FIFO, then either leave the network or travel over a link
+ * (with a fixed transit delay of at least one tick) to another station.
+ *
+ * The parallel engine partitions stations across threads, each with its own event
+ * queue. Cross-partition arrivals travel over lock-free SPSC channels, and the
+ * partitions synchronise conservatively (Chandy-Misra-Bryant) with null messages:
+ * a partition only processes an event once every input channel has promised that
+ * nothing earlier (or simultaneous) can still arrive. Link delays are the lookahead.
+ *
+ * Results are identical to the sequential engine because:
+ * - all randomness (service times, routing, external arrivals) is a pure function of
+ *   (seed, station, customer id, hop), never of which thread runs the station;
+ * - every station sees its events in (time, kind, customer id) order in both engines.
+ */
+
+using Tick = long long;
+constexpr Tick TICK_INFINITY = LLONG_MAX;
+
+// SplitMix64 finaliser: stateless, so random draws do not depend on processing order
+inline std::uint64_t mix64(std::uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline double to_unit(std::uint64_t x)                 // Uniform in (0, 1]
+{
+    return (static_cast<double>(x >> 11) + 1.0) * (1.0 / 9007199254740992.0);
+}
+
+// Exponential draw rounded up to whole ticks, at least one tick
+inline Tick exponential_ticks(std::uint64_t x, double mean)
+{
+    return std::max<Tick>(1, static_cast<Tick>(std::ceil(-mean * std::log(to_unit(x)))));
+}
+
+struct Link {
+    int destination;
+    Tick delay;                                         // >= 1: the lookahead of the parallel engine
+};
+
+struct StationSpec {
+    int num_tellers;
+    double mean_service;
+    double external_arrival_rate;                       // customers per tick arriving from outside
+    double exit_probability;
+    std::vector<Link> links;
+};
+
+struct Network {
+    std::vector<StationSpec> stations;
+    std::uint64_t seed;
+    Tick end_time;                                      // Events at or after end_time are not processed
+};
+
+struct NetCustomer {
+    std::uint64_t id;                                   // (origin station << 40) | sequence number
+    Tick entry_time;                                    // Entered the network
+    Tick arrival_time;                                  // Arrived at the current station
+    int hop;
+};
+
+enum class NetEventType { DEPARTURE = 0, ARRIVAL = 1 };
+
+struct NetEvent {
+    Tick time;
+    int station;
+    NetEventType type;
+    bool external;                                      // Arrival from outside the network
+    NetCustomer customer;
+
+    // Total order on (time, station, type, id): ties never depend on insertion order
+    bool operator>(const NetEvent& other) const {
+        if (time != other.time) return time > other.time;
+        if (station != other.station) return station > other.station;
+        if (type != other.type) return type > other.type;
+        return customer.id > other.customer.id;
+    }
+};
+
+struct StationStats {
+    long long arrivals = 0;
+    long long served = 0;
+    long long exits = 0;
+    long long max_line_length = 0;
+    Tick total_wait_time = 0;
+    Tick total_sojourn_time = 0;                        // Network entry -> exit, for customers leaving here
+    LogHistogram<> wait_times;
+
+    bool operator==(const StationStats& other) const {
+        return arrivals == other.arrivals && served == other.served && exits == other.exits &&
+               max_line_length == other.max_line_length && total_wait_time == other.total_wait_time &&
+               total_sojourn_time == other.total_sojourn_time &&
+               wait_times.percentile(0.5) == other.wait_times.percentile(0.5) &&
+               wait_times.percentile(0.99) == other.wait_times.percentile(0.99) &&
+               wait_times.max() == other.wait_times.max();
+    }
+};
+
+/**
+ * Lock-Free Unbounded SPSC Channel
+ * Linked list with a stub node: the producer only touches tail_, the consumer only
+ * head_, and the release/acquire pair on next publishes each value.
+ * Unbounded, so a producer never blocks (bounded channels can deadlock in cycles).
+ */
+template <typename T>
+class SpscChannel
+{
+public:
+    SpscChannel() : head_(new Node), tail_(head_) {}
+
+    SpscChannel(const SpscChannel&) = delete;
+    SpscChannel& operator=(const SpscChannel&) = delete;
+
+    ~SpscChannel()
+    {
+        while (head_) {
+            Node* next = head_->next.load(std::memory_order_relaxed);
+            delete head_;
+            head_ = next;
+        }
+    }
+
+    void push(const T& value)                           // Producer thread only
+    {
+        Node* node = new Node;
+        node->value = value;
+        tail_->next.store(node, std::memory_order_release);
+        tail_ = node;
+    }
+
+    bool pop(T& value)                                  // Consumer thread only
+    {
+        Node* next = head_->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        value = next->value;
+        delete head_;                                   // Old stub; next becomes the new stub
+        head_ = next;
+        return true;
+    }
+
+private:
+    struct Node {
+        T value{};
+        std::atomic<Node*> next{nullptr};
+    };
+
+    alignas(64) Node* head_;                            // Consumer side
+    alignas(64) Node* tail_;                            // Producer side
+};
+
+// Cross-partition message: a routed arrival, or a null message carrying only a promise
+struct ChannelMessage {
+    bool is_null;
+    NetEvent event;                                     // event.time doubles as the promise
+};
+
+/**
+ * Partition
+ * A set of stations sharing one event queue. The sequential engine is one partition
+ * holding every station; the parallel engine runs one partition per thread.
+ */
+class Partition
+{
+public:
+    Partition(const Network& network, const std::vector<int>& partition_of, int id)
+        : network(network), partition_of(partition_of), id(id), local_index(network.stations.size(), -1)
+    {
+        for (int s = 0; s < static_cast<int>(network.stations.size()); ++s) {
+            if (partition_of[s] == id) {
+                local_index[s] = static_cast<int>(local_stations.size());
+                local_stations.push_back(s);
+            }
+        }
+
+        // Per-station state only for the stations this partition owns (StationStats is ~30 KB)
+        state.resize(local_stations.size());
+        stats.resize(local_stations.size());
+        for (int s : local_stations)
+            schedule_external_arrival(s, 0.0, 0);
+    }
+
+    // Process every queued event with time < limit (and < end_time)
+    void process_until(Tick limit)
+    {
+        limit = std::min(limit, network.end_time);
+        while (!event_queue.empty() && event_queue.top().time < limit) {
+            NetEvent event = event_queue.top();
+            event_queue.pop();
+            process_event(event);
+        }
+    }
+
+    Tick next_event_time() const { return event_queue.empty() ? TICK_INFINITY : event_queue.top().time; }
+
+    void receive(const NetEvent& event) { event_queue.push(event); }
+
+    // Arrivals bound for stations owned by another partition are handed to this callback
+    void set_remote_sink(std::function<void(const NetEvent&)> sink) { remote_sink = std::move(sink); }
+
+    const std::vector<int>& stations() const { return local_stations; }
+    // station must be owned by this partition
+    const StationStats& station_stats(int station) const { return stats[local_index[station]]; }
+    long long events_processed() const { return processed; }
+
+private:
+    struct StationState {
+        int busy = 0;
+        std::deque<NetCustomer> waiting_line;
+        double external_clock = 0.0;                    // Fractional time of the last external arrival
+        std::uint64_t external_sequence = 0;
+    };
+
+    const Network& network;
+    const std::vector<int>& partition_of;
+    int id;
+    std::vector<int> local_stations;
+    std::vector<int> local_index;                       // Global station -> index into state / stats, -1 if remote
+    std::vector<StationState> state;                    // Indexed by local index
+    std::vector<StationStats> stats;
+    std::priority_queue<NetEvent, std::vector<NetEvent>, std::greater<NetEvent>> event_queue;
+    std::function<void(const NetEvent&)> remote_sink;
+    long long processed = 0;
+
+    // hop is hashed on its own before it meets customer: a plain customer + hop would give
+    // (id, hop + 1) and (id + 1, hop) the same draws
+    std::uint64_t draw(int station, std::uint64_t customer, int hop, std::uint64_t purpose) const
+    {
+        return mix64(mix64(mix64(network.seed ^ (purpose << 56)) ^ static_cast<std::uint64_t>(station)) ^
+                     mix64(customer ^ mix64(static_cast<std::uint64_t>(hop) + 1)));
+    }
+
+    // Only the next external arrival of each station is ever queued
+    void schedule_external_arrival(int station, double clock, std::uint64_t sequence)
+    {
+        double rate = network.stations[station].external_arrival_rate;
+        if (rate <= 0.0) return;
+
+        clock += -std::log(to_unit(draw(station, sequence, 0, 1))) / rate;
+        Tick time = static_cast<Tick>(clock);
+        if (time >= network.end_time) return;
+
+        StationState& local = state[local_index[station]];
+        local.external_clock = clock;
+        local.external_sequence = sequence + 1;
+
+        NetCustomer customer{(static_cast<std::uint64_t>(station) << 40) | sequence, time, time, 0};
+        event_queue.push(NetEvent{time, station, NetEventType::ARRIVAL, true, customer});
+    }
+
+    void process_event(const NetEvent& event)
+    {
+        processed++;
+        int s = event.station;
+        StationState& local = state[local_index[s]];
+        StationStats& local_stats = stats[local_index[s]];
+        if (event.type == NetEventType::ARRIVAL) {
+            if (event.external)
+                schedule_external_arrival(s, local.external_clock, local.external_sequence);
+
+            local_stats.arrivals++;
+            if (local.busy < network.stations[s].num_tellers) {
+                start_service(s, event.time, event.customer);
+            } else {
+                local.waiting_line.push_back(event.customer);
+                local_stats.max_line_length = std::max(local_stats.max_line_length,
+                                                       static_cast<long long>(local.waiting_line.size()));
+            }
+        } else {
+            local.busy--;
+            route(s, event.time, event.customer);
+
+            if (!local.waiting_line.empty()) {
+                NetCustomer next = local.waiting_line.front();
+                local.waiting_line.pop_front();
+                start_service(s, event.time, next);
+            }
+        }
+    }
+
+    void start_service(int s, Tick now, const NetCustomer& customer)
+    {
+        state[local_index[s]].busy++;
+        Tick wait = now - customer.arrival_time;
+        StationStats& local_stats = stats[local_index[s]];
+        local_stats.served++;
+        local_stats.total_wait_time += wait;
+        local_stats.wait_times.record(static_cast<std::uint64_t>(wait));
+
+        Tick service = exponential_ticks(draw(s, customer.id, customer.hop, 2), network.stations[s].mean_service);
+        event_queue.push(NetEvent{now + service, s, NetEventType::DEPARTURE, false, customer});
+    }
+
+    void route(int s, Tick now, NetCustomer customer)
+    {
+        const StationSpec& spec = network.stations[s];
+        std::uint64_t r = draw(s, customer.id, customer.hop, 3);
+
+        if (spec.links.empty() || to_unit(r) <= spec.exit_probability) {
+            StationStats& local_stats = stats[local_index[s]];
+            local_stats.exits++;
+            local_stats.total_sojourn_time += now - customer.entry_time;
+            return;
+        }
+
+        const Link& link = spec.links[mix64(r) % spec.links.size()];
+        customer.hop++;
+        customer.arrival_time = now + link.delay;
+        NetEvent arrival{customer.arrival_time, link.destination, NetEventType::ARRIVAL, false, customer};
+
+        if (partition_of[link.destination] == id)
+            event_queue.push(arrival);
+        else
+            remote_sink(arrival);
+    }
+};
+
+struct NetworkResult {
+    std::vector<StationStats> stations;
+    long long events = 0;
+    double elapsed_ms = 0.0;
+};
+
+NetworkResult run_sequential(const Network& network)
+{
+    std::vector<int> partition_of(network.stations.size(), 0);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Partition partition(network, partition_of, 0);
+    partition.process_until(TICK_INFINITY);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    NetworkResult result;
+    for (int s = 0; s < static_cast<int>(network.stations.size()); ++s)
+        result.stations.push_back(partition.station_stats(s));
+    result.events = partition.events_processed();
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return result;
+}
+
+NetworkResult run_parallel(const Network& network, int num_partitions)
+{
+    const int num_stations = static_cast<int>(network.stations.size());
+    num_partitions = std::max(1, std::min(num_partitions, num_stations));
+
+    // Contiguous blocks of stations per partition
+    std::vector<int> partition_of(num_stations);
+    for (int s = 0; s < num_stations; ++s)
+        partition_of[s] = static_cast<int>(static_cast<long long>(s) * num_partitions / num_stations);
+
+    // Lookahead per partition pair: the smallest link delay from p into q
+    std::vector<std::vector<Tick>> lookahead(num_partitions, std::vector<Tick>(num_partitions, TICK_INFINITY));
+    for (int s = 0; s < num_stations; ++s) {
+        for (const Link& link : network.stations[s].links) {
+            int p = partition_of[s], q = partition_of[link.destination];
+            if (p != q) lookahead[p][q] = std::min(lookahead[p][q], link.delay);
+        }
+    }
+
+    // channels[p][q]: p -> q, only created where a link exists
+    std::vector<std::vector<std::unique_ptr<SpscChannel<ChannelMessage>>>> channels(num_partitions);
+    for (int p = 0; p < num_partitions; ++p) {
+        channels[p].resize(num_partitions);
+        for (int q = 0; q < num_partitions; ++q)
+            if (lookahead[p][q] != TICK_INFINITY) channels[p][q] = std::make_unique<SpscChannel<ChannelMessage>>();
+    }
+
+    std::vector<std::unique_ptr<Partition>> partitions;
+    for (int p = 0; p < num_partitions; ++p)
+        partitions.push_back(std::make_unique<Partition>(network, partition_of, p));
+
+    auto run_partition = [&](int p) {
+        Partition& partition = *partitions[p];
+        std::vector<Tick> sent(num_partitions, 0);       // Last promise (null message) on each output
+        std::vector<Tick> clock(num_partitions, 0);      // Promise received on each input
+
+        partition.set_remote_sink([&](const NetEvent& event) {
+            int q = partition_of[event.station];
+            channels[p][q]->push(ChannelMessage{false, event});
+        });
+
+        while (true) {
+            // Drain inputs. Only null messages advance a channel's clock: arrivals over links
+            // with different delays are not sent in timestamp order
+            Tick safe = TICK_INFINITY;
+            for (int q = 0; q < num_partitions; ++q) {
+                if (!channels[q][p]) continue;
+                ChannelMessage message;
+                while (channels[q][p]->pop(message)) {
+                    if (message.is_null)
+                        clock[q] = std::max(clock[q], message.event.time);
+                    else
+                        partition.receive(message.event);
+                }
+                safe = std::min(safe, clock[q]);
+            }
+
+            // Strictly below the promise: all events at a given time are present before any is processed
+            Tick before = partition.next_event_time();
+            partition.process_until(safe);
+
+            // Nothing processed from now on can be earlier than this, so no output can be earlier
+            // than it plus the link lookahead
+            Tick lower_bound = std::min(partition.next_event_time(), safe);
+            bool done = lower_bound >= network.end_time;
+
+            for (int q = 0; q < num_partitions; ++q) {
+                if (!channels[p][q]) continue;
+                Tick promise = done || lower_bound > TICK_INFINITY - lookahead[p][q]
+                                   ? TICK_INFINITY : lower_bound + lookahead[p][q];
+                if (promise > sent[q]) {
+                    NetEvent null_event{};
+                    null_event.time = promise;
+                    channels[p][q]->push(ChannelMessage{true, null_event});
+                    sent[q] = promise;
+                }
+            }
+
+            if (done) return;
+            if (partition.next_event_time() == before) std::this_thread::yield();
+        }
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 1; p < num_partitions; ++p)
+        threads.emplace_back(run_partition, p);
+    run_partition(0);
+    for (auto& t : threads)
+        t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    NetworkResult result;
+    for (int s = 0; s < num_stations; ++s)
+        result.stations.push_back(partitions[partition_of[s]]->station_stats(s));
+    for (const auto& partition : partitions)
+        result.events += partition->events_processed();
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return result;
+}
+
+// Random sparse network: every station links to a few others, loads kept below saturation
+Network make_network(int num_stations, Tick end_time, std::uint64_t seed)
+{
+    Network network;
+    network.seed = seed;
+    network.end_time = end_time;
+
+    for (int s = 0; s < num_stations; ++s) {
+        std::uint64_t r = mix64(seed ^ mix64(static_cast<std::uint64_t>(s)));
+        StationSpec spec;
+        spec.num_tellers = 1 + static_cast<int>(r % 3);
+        spec.mean_service = 2.0 + static_cast<double>((r >> 8) % 4);
+        spec.external_arrival_rate = 0.02;
+        spec.exit_probability = 0.3;
+
+        for (int l = 0; l < 3; ++l) {
+            std::uint64_t lr = mix64(r + static_cast<std::uint64_t>(l));
+            spec.links.push_back(Link{static_cast<int>(lr % num_stations), 1 + static_cast<Tick>((lr >> 32) % 5)});
+        }
+        network.stations.push_back(spec);
+    }
+    return network;
+}
+
+// Usage: ./network_simulation [stations] [threads] [end_time]
+int main(int argc, char* argv[])
+{
+    int num_stations = argc > 1 ? std::atoi(argv[1]) : 200;
+    int threads = argc > 2 ? std::atoi(argv[2]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    Tick end_time = argc > 3 ? std::atoll(argv[3]) : 200000;
+
+    if (num_stations < 1 || threads < 1 || end_time < 1) {
+        std::cerr << "Usage: " << argv[0] << " [stations] [threads] [end_time]" << std::endl;
+        return 1;
+    }
+
+    Network network = make_network(num_stations, end_time, 2024);
+
+    NetworkResult sequential = run_sequential(network);
+    NetworkResult parallel = run_parallel(network, threads);
+
+    long long served = 0, exits = 0;
+    Tick wait = 0;
+    for (const auto& s : sequential.stations) {
+        served += s.served;
+        exits += s.exits;
+        wait += s.total_wait_time;
+    }
+
+    std::cout << "Stations: " << num_stations << "   Events: " << sequential.events << "\n";
+    std::cout << "Customers served: " << served << "   Exited: " << exits << "\n";
+    std::cout << "Average wait per visit: " << (served ? static_cast<double>(wait) / served : 0.0) << " ticks\n";
+    std::cout << "Sequential: " << sequential.elapsed_ms << " ms\n";
+    std::cout << "Parallel (" << threads << " threads): " << parallel.elapsed_ms << " ms\n";
+
+    bool identical = sequential.events == parallel.events && sequential.stations == parallel.stations;
+    std::cout << "Results identical: " << (identical ? "yes" : "NO") << std::endl;
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * Log-Bucketed Histogram (HDR-style)
+ * Records non-negative integer samples in O(1) with bounded relative error,
+ * using a fixed block of counters regardless of how many samples are recorded.
+ *
+ * Values below 2^SubBucketBits get an exact bucket each. Above that, every power
+ * of two range [2^k, 2^(k+1)) is split into 2^(SubBucketBits-1) equal sub-buckets,
+ * so the relative error of any reported value is below 2^-(SubBucketBits-1).
+ * With the default of 7 bits that is under 1.6%, over the full 64-bit range.
+ */
+template <int SubBucketBits = 7>
+class LogHistogram
+{
+public:
+    static constexpr std::uint64_t sub_buckets = std::uint64_t(1) << SubBucketBits;
+    static constexpr std::uint64_t half_buckets = sub_buckets / 2;
+    static constexpr size_t num_buckets = sub_buckets + (64 - SubBucketBits) * half_buckets;
+
+    void record(std::uint64_t value)
+    {
+        counts_[bucket_index(value)]++;
+        total_++;
+        if (value > max_) max_ = value;
+    }
+
+    std::uint64_t count() const { return total_; }
+    std::uint64_t max() const { return max_; }
+
+    /**
+     * Value at quantile q in [0, 1], e.g. 0.99 for p99
+     * Returns the midpoint of the bucket holding the q-th sample (exact below 2^SubBucketBits)
+     */
+    std::uint64_t percentile(double q) const
+    {
+        if (total_ == 0) return 0;
+
+        q = std::clamp(q, 0.0, 1.0);
+        std::uint64_t rank = static_cast<std::uint64_t>(q * static_cast<double>(total_ - 1)) + 1;
+
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < num_buckets; ++i)
+        {
+            seen += counts_[i];
+            if (seen >= rank)
+                return std::min(bucket_midpoint(i), max_);
+        }
+        return max_;
+    }
+
+    void clear()
+    {
+        counts_.fill(0);
+        total_ = 0;
+        max_ = 0;
+    }
+
+private:
+    std::array<std::uint64_t, num_buckets> counts_{};
+    std::uint64_t total_ = 0;
+    std::uint64_t max_ = 0;
+
+    static size_t bucket_index(std::uint64_t value)
+    {
+        if (value < sub_buckets) return static_cast<size_t>(value);
+
+        // shift >= 1 keeps the top SubBucketBits bits: mantissa lands in [half_buckets, sub_buckets)
+        int shift = (63 - __builtin_clzll(value)) - (SubBucketBits - 1);
+        std::uint64_t mantissa = value >> shift;
+        return static_cast<size_t>(sub_buckets + (shift - 1) * half_buckets + (mantissa - half_buckets));
+    }
+
+    static std::uint64_t bucket_midpoint(size_t index)
+    {
+        if (index < sub_buckets) return index;
+
+        std::uint64_t offset = index - sub_buckets;
+        int shift = static_cast<int>(offset / half_buckets) + 1;
+        std::uint64_t mantissa = offset % half_buckets + half_buckets;
+        std::uint64_t low = mantissa << shift;
+        return low + ((std::uint64_t(1) << shift) - 1) / 2;
+    }
+};
+
+/**
+ * Time-Weighted Average
+ * Integrates a piecewise-constant signal (queue length, busy tellers, ...) over
+ * simulated time. update() is called whenever the signal changes: O(1), no history kept.
+ */
+class TimeWeightedAverage
+{
+public:
+    void update(long long now, long long new_value)
+    {
+        area_ += static_cast<double>(value_) * static_cast<double>(now - last_time_);
+        last_time_ = now;
+        value_ = new_value;
+    }
+
+    // Average over [0, now]; now must be >= the time of the last update
+    double average(long long now) const
+    {
+        if (now <= 0) return static_cast<double>(value_);
+        double area = area_ + static_cast<double>(value_) * static_cast<double>(now - last_time_);
+        return area / static_cast<double>(now);
+    }
+
+    long long value() const { return value_; }
+
+private:
+    double area_ = 0.0;
+    long long last_time_ = 0;
+    long long value_ = 0;
+};
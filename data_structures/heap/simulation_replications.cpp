@@ -0,0 +1,189 @@
+#include "event_simulation.h"
+
+#include <atomic>
+#include <thread>
+#include <iomanip>
+#include <cstdlib>
+
+/**
+ * Independent Replication Runner
+ * Runs many independent Simulation replications across all cores and aggregates
+ * them into means and 95% confidence intervals, optionally sweeping the teller count.
+ *
+ * - Every (teller count, replication) pair is one job with its own RNG stream,
+ *   derived from (base_seed, num_tellers, replication) only.
+ * - Each job runs against a private pool resource, so replications never share
+ *   an allocator (and never contend on the global heap lock).
+ * - Workers claim jobs with an atomic counter and write into their own result
+ *   slot; aggregation happens after join, in job order. Results are therefore
+ *   bit-identical for any number of threads.
+ */
+
+struct ReplicationConfig {
+    int min_tellers = 1;
+    int max_tellers = 1;                                // min == max runs a single configuration
+    int replications = 100;
+    unsigned long long customers_per_replication = 100000;
+    double arrival_rate = 0.5;                          // customers per tick
+    double mean_service = 3.0;                          // ticks
+    std::uint64_t base_seed = 42;
+    unsigned threads = 0;                               // 0 = std::thread::hardware_concurrency()
+};
+
+struct ReplicationResult {
+    double avg_wait_time = 0.0;
+    double max_line_length = 0.0;
+    double p99_wait_time = 0.0;
+    double utilization = 0.0;
+};
+
+struct Estimate {
+    double mean = 0.0;
+    double half_width = 0.0;                            // 95% confidence interval: mean +/- half_width
+};
+
+struct SweepPoint {
+    int num_tellers;
+    Estimate avg_wait_time;
+    Estimate max_line_length;
+    Estimate p99_wait_time;
+    Estimate utilization;
+};
+
+// Seed for one replication: a pure function of its identity, never of scheduling
+std::uint64_t replication_seed(std::uint64_t base_seed, int num_tellers, int replication) {
+    std::seed_seq seq{static_cast<std::uint32_t>(base_seed), static_cast<std::uint32_t>(base_seed >> 32),
+                      static_cast<std::uint32_t>(num_tellers), static_cast<std::uint32_t>(replication)};
+    std::uint32_t words[2];
+    seq.generate(words, words + 2);
+    return (static_cast<std::uint64_t>(words[0]) << 32) | words[1];
+}
+
+ReplicationResult run_replication(const ReplicationConfig& config, int num_tellers, int replication) {
+    std::pmr::unsynchronized_pool_resource arena;       // Private to this replication (and this thread)
+
+    PoissonArrivalSource source(config.arrival_rate, config.mean_service, config.customers_per_replication,
+                                replication_seed(config.base_seed, num_tellers, replication), &arena);
+    Simulation simulation(num_tellers, &arena);
+    simulation.run(source);
+
+    const auto& stats = simulation.get_statistics();
+    ReplicationResult result;
+    result.avg_wait_time = stats.average_wait_time();
+    result.max_line_length = static_cast<double>(stats.max_line_length);
+    result.p99_wait_time = static_cast<double>(stats.wait_times.percentile(0.99));
+    result.utilization = stats.utilization();
+    return result;
+}
+
+// Two-sided 95% Student t quantile; normal approximation beyond 30 degrees of freedom
+double t_quantile_95(int degrees_of_freedom) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (degrees_of_freedom < 1) return 0.0;
+    if (degrees_of_freedom <= 30) return table[degrees_of_freedom - 1];
+    return 1.960;
+}
+
+// Welford accumulation in a fixed order keeps the floating point result reproducible
+template <typename Field>
+Estimate estimate(const std::vector<ReplicationResult>& results, size_t first, size_t count, Field field) {
+    double mean = 0.0, m2 = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        double x = results[first + i].*field;
+        double delta = x - mean;
+        mean += delta / static_cast<double>(i + 1);
+        m2 += delta * (x - mean);
+    }
+
+    Estimate e;
+    e.mean = mean;
+    if (count > 1) {
+        double std_error = std::sqrt(m2 / static_cast<double>(count - 1) / static_cast<double>(count));
+        e.half_width = t_quantile_95(static_cast<int>(count) - 1) * std_error;
+    }
+    return e;
+}
+
+std::vector<SweepPoint> run_replications(const ReplicationConfig& config) {
+    if (config.min_tellers < 1 || config.max_tellers < config.min_tellers || config.replications < 1)
+        throw std::invalid_argument("Invalid replication configuration");
+
+    const int configurations = config.max_tellers - config.min_tellers + 1;
+    const size_t jobs = static_cast<size_t>(configurations) * config.replications;
+
+    // One slot per job: workers never write to the same element, so no locking is needed
+    std::vector<ReplicationResult> results(jobs);
+    std::atomic<size_t> next_job(0);
+
+    auto worker = [&]() {
+        for (size_t job = next_job.fetch_add(1, std::memory_order_relaxed); job < jobs;
+             job = next_job.fetch_add(1, std::memory_order_relaxed)) {
+            int num_tellers = config.min_tellers + static_cast<int>(job / config.replications);
+            int replication = static_cast<int>(job % config.replications);
+            results[job] = run_replication(config, num_tellers, replication);
+        }
+    };
+
+    unsigned num_threads = config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    num_threads = static_cast<unsigned>(std::min<size_t>(num_threads, jobs));
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < num_threads; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();                                           // Calling thread takes part as well
+    for (auto& t : threads) {
+        t.join();                                       // join() publishes every result slot
+    }
+
+    std::vector<SweepPoint> sweep;
+    for (int c = 0; c < configurations; ++c) {
+        size_t first = static_cast<size_t>(c) * config.replications;
+        SweepPoint point;
+        point.num_tellers = config.min_tellers + c;
+        point.avg_wait_time = estimate(results, first, config.replications, &ReplicationResult::avg_wait_time);
+        point.max_line_length = estimate(results, first, config.replications, &ReplicationResult::max_line_length);
+        point.p99_wait_time = estimate(results, first, config.replications, &ReplicationResult::p99_wait_time);
+        point.utilization = estimate(results, first, config.replications, &ReplicationResult::utilization);
+        sweep.push_back(point);
+    }
+    return sweep;
+}
+
+void print_sweep(const std::vector<SweepPoint>& sweep) {
+    std::cout << std::fixed << std::setprecision(4);
+    for (const auto& point : sweep) {
+        std::cout << "Tellers: " << point.num_tellers
+                  << "   Average wait time: " << point.avg_wait_time.mean
+                  << " +/- " << point.avg_wait_time.half_width << " ticks"
+                  << "   p99 wait time: " << point.p99_wait_time.mean
+                  << " +/- " << point.p99_wait_time.half_width << " ticks"
+                  << "   Max line length: " << point.max_line_length.mean
+                  << " +/- " << point.max_line_length.half_width << " customers"
+                  << "   Utilization: " << point.utilization.mean
+                  << " +/- " << point.utilization.half_width << "\n";
+    }
+}
+
+// Usage: ./simulation_replications [max_tellers] [replications] [customers_per_replication] [threads]
+int main(int argc, char* argv[]) {
+    ReplicationConfig config;
+    config.min_tellers = 2;
+    config.max_tellers = argc > 1 ? std::atoi(argv[1]) : 4;
+    config.replications = argc > 2 ? std::atoi(argv[2]) : 50;
+    config.customers_per_replication = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 20000;
+    config.threads = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : 0;
+
+    try {
+        print_sweep(run_replications(config));
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -25,7 +25,7 @@ public:
     threadsafe_stack(const threadsafe_stack &other)
     {
         std::lock_guard<std::mutex> lock(other.m_);
-        data = other.data_;                             // Copy performed in constructor body
+        data_ = other.data_;                            // Copy performed in constructor body
     }
 
     // Copy Operator Deleted: To Maintain Thread Safety
@@ -44,7 +44,7 @@ public:
     std::shared_ptr<T> pop()
     {
         std::lock_guard<std::mutex> lock(m_);
-        if (data_.empty() throw empty_stack());                                 // Check for empty before trying to pop value
+        if (data_.empty()) throw empty_stack();                                // Check for empty before trying to pop value
         // Allocate return value before modifying stack
         std::shared_ptr<T> const res(std::make_shared<T>(data_.top()));         // Variable Uniform Initalization with Move Semantics
         data_.pop();
@@ -55,7 +55,7 @@ public:
         std::lock_guard<std::mutex> lock(m_);
         if (data_.empty()) throw empty_stack();
         value = data_.top();
-        data.pop();
+        data_.pop();
     }
 
     bool empty() const
@@ -58,11 +58,13 @@ public:
 };
 
 // Example of a count_if() function
+// NOTE: generic_algorithms.h grows this into count_if / transform_reduce / find_if / for_each_n
+//       with vectorized and parallel variants
 template <typename Input, typename Output, typename Predicate>
 int count_if(Input start, Output end, Predicate p) {
 
     int total = 0;
-    for (Input i = start, i != end; i++) {
+    for (Input i = start; i != end; i++) {
         
         if (p(*i)) {
             total++;
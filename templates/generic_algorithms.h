@@ -0,0 +1,444 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Generic Algorithm Templates
+ * count_if, transform_reduce, find_if / find and for_each_n, grown from the count_if()
+ * example in 2_template_fundamentals.h.
+ *
+ * Each algorithm dispatches at compile time (if constexpr on type traits):
+ * - contiguous ranges of arithmetic elements: unrolled kernels with independent
+ *   accumulators and no data-dependent branches, which the compiler vectorizes
+ * - anything else: the plain iterator loop (for_each_n still unrolls any random
+ *   access range)
+ *
+ * Overloads taking generic::par split large random access ranges across threads.
+ * Results are the same as the sequential versions; as with std::transform_reduce,
+ * the reduction must be associative and commutative (floating point sums may be
+ * regrouped).
+ *
+ * Sequential find_if calls p exactly as std::find_if does: in order, stopping at
+ * the first match. Only find(), whose test is a comparison against a value, uses
+ * the block kernel that also compares elements past the match. As with
+ * std::execution::par, the parallel overloads call their function objects
+ * concurrently, and parallel find_if may call p on elements after the match.
+ */
+
+namespace generic
+{
+    // Execution policies
+    struct sequenced_policy {};
+
+    struct parallel_policy
+    {
+        unsigned threads = 0;                           // 0 = std::thread::hardware_concurrency()
+        std::size_t grain = 1 << 15;                    // Smallest chunk worth a thread
+    };
+
+    constexpr sequenced_policy seq{};
+    constexpr parallel_policy par{};
+
+    namespace detail
+    {
+        template <typename It>
+        using category_t = typename std::iterator_traits<It>::iterator_category;
+
+        template <typename It>
+        using value_t = typename std::iterator_traits<It>::value_type;
+
+        template <typename It>
+        struct is_random_access : std::is_base_of<std::random_access_iterator_tag, category_t<It>> {};
+
+        // Pointers and std::vector iterators: elements are adjacent in memory
+        template <typename It>
+        struct is_contiguous
+            : std::bool_constant<std::is_pointer<It>::value ||
+                                 std::is_same<It, typename std::vector<value_t<It>>::iterator>::value ||
+                                 std::is_same<It, typename std::vector<value_t<It>>::const_iterator>::value>
+        {};
+
+        template <typename It>
+        struct is_contiguous_arithmetic
+            : std::bool_constant<is_contiguous<It>::value && std::is_arithmetic<value_t<It>>::value &&
+                                 !std::is_same<value_t<It>, bool>::value>
+        {};
+
+        constexpr std::ptrdiff_t unroll = 8;
+
+        inline std::size_t thread_count(const parallel_policy& policy)
+        {
+            return std::max(1u, policy.threads ? policy.threads : std::thread::hardware_concurrency());
+        }
+
+        /**
+         * Run body(begin, end, chunk) over [0, n) split into contiguous chunks, one per thread.
+         * Returns the number of chunks used (1 means body ran once on the calling thread).
+         */
+        template <typename Body>
+        std::size_t split(std::ptrdiff_t n, const parallel_policy& policy, Body body)
+        {
+            std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(
+                thread_count(policy), static_cast<std::size_t>(n) / std::max<std::size_t>(1, policy.grain)));
+            std::ptrdiff_t size = (n + static_cast<std::ptrdiff_t>(chunks) - 1) / static_cast<std::ptrdiff_t>(chunks);
+
+            std::vector<std::thread> threads;
+            for (std::size_t c = 1; c < chunks; ++c)
+            {
+                std::ptrdiff_t begin = std::min(n, static_cast<std::ptrdiff_t>(c) * size);
+                threads.emplace_back(body, begin, std::min(n, begin + size), c);
+            }
+            body(std::ptrdiff_t(0), std::min(n, size), std::size_t(0));
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+            return chunks;
+        }
+    }
+
+    /**
+     * count_if
+     * Number of elements in [first, last) for which p is true
+     */
+    template <typename Input, typename Predicate>
+    std::ptrdiff_t count_if(Input first, Input last, Predicate p)
+    {
+        if constexpr (detail::is_contiguous_arithmetic<Input>::value)
+        {
+            // Independent counters, no branch on the predicate: vectorizes to compare + add
+            if (first == last) return 0;
+            const auto* data = &*first;
+            std::ptrdiff_t n = last - first;
+            std::ptrdiff_t counts[detail::unroll] = {};
+            std::ptrdiff_t i = 0;
+            for (; i + detail::unroll <= n; i += detail::unroll)
+            {
+                for (std::ptrdiff_t k = 0; k < detail::unroll; ++k)
+                {
+                    counts[k] += static_cast<bool>(p(data[i + k]));
+                }
+            }
+            for (; i < n; ++i)
+            {
+                counts[0] += static_cast<bool>(p(data[i]));
+            }
+
+            std::ptrdiff_t total = 0;
+            for (std::ptrdiff_t k = 0; k < detail::unroll; ++k) total += counts[k];
+            return total;
+        }
+        else
+        {
+            std::ptrdiff_t total = 0;
+            for (Input i = first; i != last; ++i)
+            {
+                if (p(*i)) total++;
+            }
+            return total;
+        }
+    }
+
+    /**
+     * transform_reduce
+     * reduce(init, transform(x)) over every x in [first, last)
+     */
+    template <typename Input, typename T, typename Reduce, typename Transform>
+    T transform_reduce(Input first, Input last, T init, Reduce reduce, Transform transform)
+    {
+        if constexpr (detail::is_contiguous_arithmetic<Input>::value && std::is_arithmetic<T>::value)
+        {
+            // Independent partial results break the loop-carried dependency on one accumulator
+            if (first == last) return init;
+            const auto* data = &*first;
+            std::ptrdiff_t n = last - first;
+            if (n < detail::unroll)
+            {
+                for (std::ptrdiff_t i = 0; i < n; ++i) init = reduce(init, transform(data[i]));
+                return init;
+            }
+
+            T partial[detail::unroll];
+            for (std::ptrdiff_t k = 0; k < detail::unroll; ++k) partial[k] = static_cast<T>(transform(data[k]));
+
+            std::ptrdiff_t i = detail::unroll;
+            for (; i + detail::unroll <= n; i += detail::unroll)
+            {
+                for (std::ptrdiff_t k = 0; k < detail::unroll; ++k)
+                {
+                    partial[k] = reduce(partial[k], transform(data[i + k]));
+                }
+            }
+            for (; i < n; ++i)
+            {
+                partial[0] = reduce(partial[0], transform(data[i]));
+            }
+
+            for (std::ptrdiff_t k = 0; k < detail::unroll; ++k) init = reduce(init, partial[k]);
+            return init;
+        }
+        else
+        {
+            for (Input i = first; i != last; ++i)
+            {
+                init = reduce(std::move(init), transform(*i));
+            }
+            return init;
+        }
+    }
+
+    /**
+     * find_if
+     * First iterator in [first, last) for which p is true, or last
+     */
+    template <typename Input, typename Predicate>
+    Input find_if(Input first, Input last, Predicate p)
+    {
+        for (; first != last; ++first)
+        {
+            if (p(*first)) return first;
+        }
+        return last;
+    }
+
+    /**
+     * find
+     * First iterator in [first, last) equal to value, or last
+     */
+    template <typename Input, typename T>
+    Input find(Input first, Input last, const T& value)
+    {
+        if constexpr (detail::is_contiguous_arithmetic<Input>::value && std::is_arithmetic<T>::value)
+        {
+            // Compare a whole block branch-free, then branch once per block; extra
+            // comparisons past the match have no effect, so only find() does this
+            if (first == last) return last;
+            const auto* data = &*first;
+            std::ptrdiff_t n = last - first;
+            std::ptrdiff_t i = 0;
+            for (; i + detail::unroll <= n; i += detail::unroll)
+            {
+                unsigned hits = 0;
+                for (std::ptrdiff_t k = 0; k < detail::unroll; ++k)
+                {
+                    hits |= static_cast<unsigned>(data[i + k] == value) << k;
+                }
+                if (hits) return first + (i + __builtin_ctz(hits));
+            }
+            for (; i < n; ++i)
+            {
+                if (data[i] == value) return first + i;
+            }
+            return last;
+        }
+        else
+        {
+            return generic::find_if(first, last, [&value](const auto& x) { return x == value; });
+        }
+    }
+
+    /**
+     * for_each_n
+     * Apply f to the first n elements starting at first; returns first + n
+     */
+    template <typename Input, typename Size, typename Function>
+    Input for_each_n(Input first, Size n, Function f)
+    {
+        if constexpr (detail::is_random_access<Input>::value)
+        {
+            std::ptrdiff_t count = static_cast<std::ptrdiff_t>(n);
+            std::ptrdiff_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                f(first[i]);
+                f(first[i + 1]);
+                f(first[i + 2]);
+                f(first[i + 3]);
+            }
+            for (; i < count; ++i)
+            {
+                f(first[i]);
+            }
+            return first + count;
+        }
+        else
+        {
+            for (Size i = 0; i < n; ++i, ++first)
+            {
+                f(*first);
+            }
+            return first;
+        }
+    }
+
+    // Sequenced policy overloads: same as the plain versions
+    template <typename Input, typename Predicate>
+    std::ptrdiff_t count_if(const sequenced_policy&, Input first, Input last, Predicate p)
+    {
+        return generic::count_if(first, last, p);
+    }
+
+    template <typename Input, typename T, typename Reduce, typename Transform>
+    T transform_reduce(const sequenced_policy&, Input first, Input last, T init, Reduce reduce, Transform transform)
+    {
+        return generic::transform_reduce(first, last, init, reduce, transform);
+    }
+
+    template <typename Input, typename Predicate>
+    Input find_if(const sequenced_policy&, Input first, Input last, Predicate p)
+    {
+        return generic::find_if(first, last, p);
+    }
+
+    template <typename Input, typename T>
+    Input find(const sequenced_policy&, Input first, Input last, const T& value)
+    {
+        return generic::find(first, last, value);
+    }
+
+    template <typename Input, typename Size, typename Function>
+    Input for_each_n(const sequenced_policy&, Input first, Size n, Function f)
+    {
+        return generic::for_each_n(first, n, f);
+    }
+
+    /**
+     * Parallel policy overloads
+     * Random access ranges are cut into one contiguous chunk per thread, each chunk
+     * runs the sequential kernel, and partial results are combined in chunk order.
+     * Other iterator categories fall back to the sequential versions.
+     */
+    template <typename Input, typename Predicate>
+    std::ptrdiff_t count_if(const parallel_policy& policy, Input first, Input last, Predicate p)
+    {
+        if constexpr (detail::is_random_access<Input>::value)
+        {
+            std::vector<std::ptrdiff_t> partial(detail::thread_count(policy));
+            std::size_t chunks = detail::split(last - first, policy,
+                [&](std::ptrdiff_t begin, std::ptrdiff_t end, std::size_t c) {
+                    partial[c] = generic::count_if(first + begin, first + end, p);
+                });
+
+            std::ptrdiff_t total = 0;
+            for (std::size_t c = 0; c < chunks; ++c) total += partial[c];
+            return total;
+        }
+        else
+        {
+            return generic::count_if(first, last, p);
+        }
+    }
+
+    template <typename Input, typename T, typename Reduce, typename Transform>
+    T transform_reduce(const parallel_policy& policy, Input first, Input last, T init, Reduce reduce,
+                       Transform transform)
+    {
+        if constexpr (detail::is_random_access<Input>::value)
+        {
+            // Each chunk reduces from its own first element, so init is folded in exactly once
+            std::vector<T> partial(detail::thread_count(policy));
+            std::vector<char> has_partial(partial.size(), 0);
+            std::size_t chunks = detail::split(last - first, policy,
+                [&](std::ptrdiff_t begin, std::ptrdiff_t end, std::size_t c) {
+                    if (begin == end) return;
+                    T first_value = transform(first[begin]);
+                    partial[c] = generic::transform_reduce(first + begin + 1, first + end, std::move(first_value),
+                                                           reduce, transform);
+                    has_partial[c] = 1;
+                });
+
+            for (std::size_t c = 0; c < chunks; ++c)
+            {
+                if (has_partial[c]) init = reduce(std::move(init), std::move(partial[c]));
+            }
+            return init;
+        }
+        else
+        {
+            return generic::transform_reduce(first, last, init, reduce, transform);
+        }
+    }
+
+    namespace detail
+    {
+        /**
+         * Parallel first-match search: find_block(block_first, block_last) searches one block.
+         * The lowest match so far is shared, and chunks stop once they pass it.
+         */
+        template <typename Input, typename FindBlock>
+        Input parallel_find(const parallel_policy& policy, Input first, Input last, FindBlock find_block)
+        {
+            const std::ptrdiff_t n = last - first;
+            std::atomic<std::ptrdiff_t> best(n);
+            split(n, policy, [&](std::ptrdiff_t begin, std::ptrdiff_t end, std::size_t) {
+                constexpr std::ptrdiff_t block = 4096;
+                for (std::ptrdiff_t b = begin; b < end && b < best.load(std::memory_order_relaxed); b += block)
+                {
+                    std::ptrdiff_t block_end = std::min(end, b + block);
+                    Input found = find_block(first + b, first + block_end);
+                    if (found != first + block_end)
+                    {
+                        std::ptrdiff_t index = found - first;
+                        std::ptrdiff_t current = best.load(std::memory_order_relaxed);
+                        while (index < current && !best.compare_exchange_weak(current, index)) {}
+                        return;
+                    }
+                }
+            });
+            return first + best.load();
+        }
+    }
+
+    template <typename Input, typename Predicate>
+    Input find_if(const parallel_policy& policy, Input first, Input last, Predicate p)
+    {
+        if constexpr (detail::is_random_access<Input>::value)
+        {
+            return detail::parallel_find(policy, first, last,
+                                         [&p](Input begin, Input end) { return generic::find_if(begin, end, p); });
+        }
+        else
+        {
+            return generic::find_if(first, last, p);
+        }
+    }
+
+    template <typename Input, typename T>
+    Input find(const parallel_policy& policy, Input first, Input last, const T& value)
+    {
+        if constexpr (detail::is_random_access<Input>::value)
+        {
+            return detail::parallel_find(policy, first, last,
+                                         [&value](Input begin, Input end) { return generic::find(begin, end, value); });
+        }
+        else
+        {
+            return generic::find(first, last, value);
+        }
+    }
+
+    template <typename Input, typename Size, typename Function>
+    Input for_each_n(const parallel_policy& policy, Input first, Size n, Function f)
+    {
+        if constexpr (detail::is_random_access<Input>::value)
+        {
+            detail::split(static_cast<std::ptrdiff_t>(n), policy,
+                [&](std::ptrdiff_t begin, std::ptrdiff_t end, std::size_t) {
+                    generic::for_each_n(first + begin, end - begin, f);
+                });
+            return first + static_cast<std::ptrdiff_t>(n);
+        }
+        else
+        {
+            return generic::for_each_n(first, n, f);
+        }
+    }
+}